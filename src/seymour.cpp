@@ -39,6 +39,69 @@ SOFTWARE.
 #include <math.h>
 #include <string.h>
 #include <new>
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// tanh used by the Soft and Tube saturation curves:
+//   0 - libm tanhf()
+//   1 - 7/6 rational (Lambert continued fraction), clamped at |x| = 4.97;
+//       max abs error vs tanhf() 9.6e-5
+//   2 - 257-entry table over 0..8 with linear interpolation;
+//       max abs error vs tanhf() 9.4e-5
+#ifndef SEYMOUR_FAST_TANH
+#define SEYMOUR_FAST_TANH 1
+#endif
+
+// Feedback delay layout:
+//   1 - one contiguous ring per channel (structure of arrays)
+//   0 - frames interleaved across channels
+#ifndef SEYMOUR_FEEDBACK_SOA
+#define SEYMOUR_FEEDBACK_SOA 1
+#endif
+
+// Feedback and pan/mix pass:
+//   1 - channel-parallel, four channels per SSE/NEON vector
+//   0 - one channel at a time (scalar)
+// Defaults to 1 where SSE or NEON is available (desktop and nt_emu builds);
+// the Cortex-M7 hardware target has neither and keeps the scalar pass.
+#ifndef SEYMOUR_SIMD
+#if defined(__SSE__) || defined(_M_X64) || defined(__ARM_NEON)
+#define SEYMOUR_SIMD 1
+#else
+#define SEYMOUR_SIMD 0
+#endif
+#endif
+
+// Instrumentation build: time step() and its stages with the Cortex-M7 DWT
+// cycle counter (the TSC on x86 hosts) and show the figures, with the
+// limiter's gain reduction and envelope, via draw(). 0 compiles it all out.
+#ifndef SEYMOUR_INSTRUMENT
+#define SEYMOUR_INSTRUMENT 0
+#endif
+
+// Host tools build (tools/render): adds the original per-sample step() as a
+// reference kernel and lets the tool switch an instance between kernels.
+// Never set for plug-in builds.
+#ifndef SEYMOUR_HOST_TOOLS
+#define SEYMOUR_HOST_TOOLS 0
+#endif
+
+#if SEYMOUR_HOST_TOOLS
+#include "../tools/seymour_host.h"
+#endif
+
+// Core clock used to turn cycles into a share of the audio budget
+#ifndef SEYMOUR_CPU_HZ
+#define SEYMOUR_CPU_HZ 600000000
+#endif
+
+#if SEYMOUR_INSTRUMENT && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
 
 // ============================================================================
 // CONSTANTS
@@ -50,10 +113,64 @@ enum { kMaxChannels = 8 };
 static const float kLimiterThresholdMaxVolts = 10.0f; // least squash
 static const float kLimiterThresholdMinVolts = 1.0f;  // most squash
 
-// Maximum lookahead buffer size (20ms @ 96kHz, stereo interleaved)
-static const int kMaxLookaheadSamples = (96000 * 20) / 1000;
-// Maximum feedback delay buffer size (20ms @ 96kHz, per channel)
-static const int kMaxFeedbackDelaySamples = (96000 * 20) / 1000;
+// Longest lookahead / feedback delay an instance can be created with (ms).
+// The "Max delay" specification picks the actual limit and the buffers are
+// sized from it and the sample rate.
+enum { kMaxDelayMs = 20 };
+
+// step() works through the host block in chunks of at most this many frames
+enum { kBlockFrames = 32 };
+// Control-rate interval for modulated parameters (pan), in frames
+enum { kControlFrames = 8 };
+// Limiter gain update interval for the envelope detector, in frames; the
+// gain is interpolated between updates
+enum { kDetectorFrames = 4 };
+
+// Quarter-sine table resolution for the control-rate panner (max error ~7.5e-5)
+enum { kPanTableSize = 64 };
+// tanh table resolution for SEYMOUR_FAST_TANH == 2 (entries per unit of x, up to kTanhTableRange)
+enum { kTanhTableStepsPerUnit = 32, kTanhTableRange = 8, kTanhTableSize = kTanhTableStepsPerUnit * kTanhTableRange };
+
+// Feedback signals below this level (volts) count as silence for idle detection
+static const float kSilenceThresholdVolts = 1.0e-6f;
+// A smoothed global parameter this close to its target snaps onto it and
+// stays constant (Cascade then reaches exactly 0% for the pure-mixer path)
+static const float kSmootherSettleThreshold = 1.0e-5f;
+// A limiter gain this close to unity with nothing over threshold is at rest
+static const float kGainRestThreshold = 0.99999f;
+
+// Filter and detector states below this are flushed to zero once per chunk
+static const float kDenormalFloor = 1.0e-15f;
+
+// A smoothed pan this close to its target (in pan units) is treated as settled
+static const float kPanSettleThreshold = 0.01f;
+
+// Shortest feedback tap delay (frames), so an interpolated tap always has a
+// whole earlier frame on both sides
+static const float kMinTapDelayFrames = 2.0f;
+// Fastest a CV-modulated tap delay may change, in frames per frame; keeps
+// the read position moving forwards at 0.5x to 1.5x speed
+static const float kMaxTapDelaySlew = 0.5f;
+
+// Halfband stages of the oversampled saturation, as the number of distinct
+// interpolation weights each (see halfbandA and halfbandB)
+enum { kHalfbandTapsA = 8, kHalfbandTapsB = 2 };
+// Round trip through the stages in base frames - the delay the oversampler
+// gives the linear part of the signal
+enum { kOversampleLatency2x = 2 * kHalfbandTapsA, kOversampleLatency4x = 2 * kHalfbandTapsA + kHalfbandTapsB };
+// Base frames of limited signal and threshold history the oversampler keeps
+enum { kOversampleHistory = kOversampleLatency4x };
+// Frames the decimators keep running after the last saturating frame; by
+// then their history is all zero again
+enum { kOversampleTailFrames = 2 * kOversampleHistory };
+
+// Gain reduction CV output scale (1V per 6dB), and the limit of both CV outputs
+static const float kGainReductionVoltsPerDb = 1.0f / 6.0f;
+static const float kCVOutputMaxVolts = 10.0f;
+
+// Lite clipper knee as a fraction of the Squash threshold: below it the
+// signal passes untouched, above it the saturation curve takes over
+static const float kClipperKnee = 0.5f;
 
 // ============================================================================
 // PARAMETER INDICES
@@ -71,6 +188,12 @@ enum GlobalParams {
     kParamSaturation,
     kParamFeedbackDelay,
     kParamSquash,
+    kParamDetector,
+    kParamTopology,
+    kParamOversample,
+    kParamGROutput,      // limiter gain reduction CV out
+    kParamEnvOutput,     // limiter envelope CV out
+    kParamLink,          // limiter stereo link
 
     kNumGlobalParameters,
 };
@@ -85,6 +208,24 @@ enum ChannelParams {
     kNumPerChannelParameters,
 };
 
+// Per-channel delay parameters - a second block of them after the globals,
+// so existing parameter indices are unchanged
+enum ChannelDelayParams {
+    kChParamDelay,          // feedback delay, % of the global FB Delay
+    kChParamDelayCV,
+    kChParamDelayCVDepth,
+
+    kNumPerChannelDelayParameters,
+};
+
+/**
+ * Parameter count for numChannels channels: the per-channel block, the
+ * globals, then the per-channel delay block
+ */
+static inline int numParameters(int32_t numChannels) {
+    return numChannels * (kNumPerChannelParameters + kNumPerChannelDelayParameters) + kNumGlobalParameters;
+}
+
 // Saturation modes
 enum SaturationMode {
     kSaturationSoft = 0,
@@ -92,11 +233,35 @@ enum SaturationMode {
     kSaturationHard,
 };
 
+// Limiter detectors
+enum DetectorMode {
+    kDetectorEnvelope = 0,  // one-pole envelope on the undelayed peak
+    kDetectorWindow,        // sliding-window peak over the whole lookahead
+};
+
+// Limiter stereo link - what each of the two detector sides listens to
+enum LinkMode {
+    kLinkLinked = 0,        // one detector on the louder of L and R, one gain for both
+    kLinkUnlinked,          // L and R each with their own detector and gain
+    kLinkMidSide,           // mid (L+R)/2 and side (L-R)/2 each with their own
+};
+
+// Feedback topologies - which lanes each channel's feedback tap is taken from
+enum TopologyMode {
+    kTopologyRing = 0,      // Ch 0 <- Ch N-1, Ch 1 <- Ch 0, ...
+    kTopologyHadamard,      // normalised Walsh-Hadamard mix of every lane
+    kTopologyHouseholder,   // Householder reflection of every lane, I - 2/N
+};
+
 // ============================================================================
 // PARAMETER TEMPLATES
 // ============================================================================
 
 static const char* saturationStrings[] = { "Soft", "Tube", "Hard", NULL };
+static const char* detectorStrings[] = { "Envelope", "Window", NULL };
+static const char* topologyStrings[] = { "Ring", "Hadamard", "Householder", NULL };
+static const char* oversampleStrings[] = { "Off", "2x", "4x", NULL };
+static const char* linkStrings[] = { "Linked", "Unlinked", "Mid-Side", NULL };
 
 // Global parameters template
 static const _NT_parameter globalParameters[] = {
@@ -110,6 +275,12 @@ static const _NT_parameter globalParameters[] = {
     { .name = "FB Delay", .min = 5, .max = 200, .def = 50, .unit = kNT_unitMs, .scaling = kNT_scaling10, .enumStrings = NULL },
     // 0% = least squash (higher threshold), 100% = most squash (lower threshold)
     { .name = "Squash", .min = 0, .max = 100, .def = 56, .unit = kNT_unitPercent, .scaling = 0, .enumStrings = NULL },
+    { .name = "Detector", .min = 0, .max = 1, .def = 0, .unit = kNT_unitEnum, .scaling = 0, .enumStrings = detectorStrings },
+    { .name = "Topology", .min = 0, .max = 2, .def = 0, .unit = kNT_unitEnum, .scaling = 0, .enumStrings = topologyStrings },
+    { .name = "Oversample", .min = 0, .max = 2, .def = 0, .unit = kNT_unitEnum, .scaling = 0, .enumStrings = oversampleStrings },
+    NT_PARAMETER_CV_OUTPUT("GR out", 0, 0)
+    NT_PARAMETER_CV_OUTPUT("Env out", 0, 0)
+    { .name = "Link", .min = 0, .max = 2, .def = 0, .unit = kNT_unitEnum, .scaling = 0, .enumStrings = linkStrings },
 };
 
 // Per-channel parameters template
@@ -120,6 +291,13 @@ static const _NT_parameter perChannelParameters[] = {
     { .name = "Pan Depth", .min = 0, .max = 100, .def = 50, .unit = kNT_unitPercent, .scaling = 0, .enumStrings = NULL },
 };
 
+// Per-channel delay parameters template
+static const _NT_parameter perChannelDelayParameters[] = {
+    { .name = "Delay", .min = 25, .max = 200, .def = 100, .unit = kNT_unitPercent, .scaling = 0, .enumStrings = NULL },
+    { .name = "Delay CV", .min = 0, .max = 28, .def = 0, .unit = kNT_unitCvInput, .scaling = 0, .enumStrings = NULL },
+    { .name = "Delay Depth", .min = 0, .max = 100, .def = 50, .unit = kNT_unitPercent, .scaling = 0, .enumStrings = NULL },
+};
+
 // Channel page names
 static char const * const channelPageNames[] = {
     "Channel 1", "Channel 2", "Channel 3", "Channel 4",
@@ -140,6 +318,88 @@ static inline float dcBlock(float input, float& x1, float& y1, float R) {
     return output;
 }
 
+/**
+ * Zero a decaying state before it reaches the denormal range
+ */
+static inline void flushDenormal(float& x) {
+    if (fabsf(x) < kDenormalFloor) x = 0.0f;
+}
+
+/**
+ * Puts the FPU in flush-to-zero (and denormals-are-zero where available)
+ * for the lifetime of the guard, restoring the caller's mode afterwards.
+ * Decaying feedback tails and one-pole states then never hit the slow
+ * denormal path on desktop builds; on the Cortex-M7 FZ is cheap to set and
+ * keeps the behaviour identical.
+ */
+struct _seymourDenormalGuard {
+#if defined(__SSE__) || defined(_M_X64)
+    unsigned int saved;
+    _seymourDenormalGuard() : saved(_mm_getcsr()) { _mm_setcsr(saved | 0x8040); } // FTZ | DAZ
+    ~_seymourDenormalGuard() { _mm_setcsr(saved); }
+#elif defined(__aarch64__)
+    uint64_t saved;
+    _seymourDenormalGuard() {
+        __asm__ __volatile__("mrs %0, fpcr" : "=r"(saved));
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(saved | (1ull << 24))); // FZ
+    }
+    ~_seymourDenormalGuard() { __asm__ __volatile__("msr fpcr, %0" : : "r"(saved)); }
+#elif defined(__ARM_FP)
+    uint32_t saved;
+    _seymourDenormalGuard() {
+        __asm__ __volatile__("vmrs %0, fpscr" : "=r"(saved));
+        __asm__ __volatile__("vmsr fpscr, %0" : : "r"(saved | (1u << 24))); // FZ
+    }
+    ~_seymourDenormalGuard() { __asm__ __volatile__("vmsr fpscr, %0" : : "r"(saved)); }
+#endif
+};
+
+#if SEYMOUR_SIMD
+/**
+ * Four-lane float vector for the channel-parallel pass (SEYMOUR_SIMD)
+ */
+#if defined(__SSE__) || defined(_M_X64)
+typedef __m128 _seymourVec;
+
+static inline _seymourVec vecSplat(float x) { return _mm_set1_ps(x); }
+static inline _seymourVec vecSet(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+static inline _seymourVec vecLoad(const float* p) { return _mm_loadu_ps(p); }
+static inline void vecStore(float* p, _seymourVec v) { _mm_storeu_ps(p, v); }
+static inline _seymourVec vecAdd(_seymourVec a, _seymourVec b) { return _mm_add_ps(a, b); }
+static inline _seymourVec vecSub(_seymourVec a, _seymourVec b) { return _mm_sub_ps(a, b); }
+static inline _seymourVec vecMul(_seymourVec a, _seymourVec b) { return _mm_mul_ps(a, b); }
+static inline _seymourVec vecMax(_seymourVec a, _seymourVec b) { return _mm_max_ps(a, b); }
+static inline _seymourVec vecAbs(_seymourVec a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+static inline float vecSum(_seymourVec a) {
+    __m128 sum = _mm_add_ps(a, _mm_movehl_ps(a, a));
+    return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+}
+#else
+typedef float32x4_t _seymourVec;
+
+static inline _seymourVec vecSplat(float x) { return vdupq_n_f32(x); }
+static inline _seymourVec vecSet(float a, float b, float c, float d) {
+    const float lanes[4] = { a, b, c, d };
+    return vld1q_f32(lanes);
+}
+static inline _seymourVec vecLoad(const float* p) { return vld1q_f32(p); }
+static inline void vecStore(float* p, _seymourVec v) { vst1q_f32(p, v); }
+static inline _seymourVec vecAdd(_seymourVec a, _seymourVec b) { return vaddq_f32(a, b); }
+static inline _seymourVec vecSub(_seymourVec a, _seymourVec b) { return vsubq_f32(a, b); }
+static inline _seymourVec vecMul(_seymourVec a, _seymourVec b) { return vmulq_f32(a, b); }
+static inline _seymourVec vecMax(_seymourVec a, _seymourVec b) { return vmaxq_f32(a, b); }
+static inline _seymourVec vecAbs(_seymourVec a) { return vabsq_f32(a); }
+static inline float vecSum(_seymourVec a) {
+#if defined(__aarch64__)
+    return vaddvq_f32(a);
+#else
+    float32x2_t sum = vadd_f32(vget_low_f32(a), vget_high_f32(a));
+    return vget_lane_f32(vpadd_f32(sum, sum), 0);
+#endif
+}
+#endif
+#endif
+
 /**
  * Equal power panner
  */
@@ -151,17 +411,44 @@ static inline void equalPowerPan(float pan, float& gainL, float& gainR) {
 }
 
 /**
- * Saturation functions
+ * tanh for the saturation curves - see SEYMOUR_FAST_TANH
  */
-static inline float saturateSoft(float x) {
+static inline float fastTanh(float x, const float* table) {
+#if SEYMOUR_FAST_TANH == 1
+    if (x > 4.97f) x = 4.97f;
+    if (x < -4.97f) x = -4.97f;
+    float x2 = x * x;
+    return x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)))
+             / (135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f)));
+#elif SEYMOUR_FAST_TANH == 2
+    float a = x < 0.0f ? -x : x;
+    float pos = a * kTanhTableStepsPerUnit;
+    float y;
+    if (pos >= (float)kTanhTableSize) {
+        y = table[kTanhTableSize];
+    } else {
+        int idx = (int)pos;
+        float frac = pos - idx;
+        y = table[idx] + frac * (table[idx + 1] - table[idx]);
+    }
+    return x < 0.0f ? -y : y;
+#else
     return tanhf(x);
+#endif
+}
+
+/**
+ * Saturation functions
+ */
+static inline float saturateSoft(float x, const float* tanhTable) {
+    return fastTanh(x, tanhTable);
 }
 
-static inline float saturateTube(float x) {
+static inline float saturateTube(float x, const float* tanhTable) {
     if (x >= 0.0f) {
-        return tanhf(x * 0.8f) * 1.1f;
+        return fastTanh(x * 0.8f, tanhTable) * 1.1f;
     } else {
-        return tanhf(x * 1.2f) * 0.9f;
+        return fastTanh(x * 1.2f, tanhTable) * 0.9f;
     }
 }
 
@@ -173,137 +460,774 @@ static inline float saturateHard(float x) {
     return x;
 }
 
-static inline float saturate(float x, int mode) {
-    switch (mode) {
-        case kSaturationSoft: return saturateSoft(x);
-        case kSaturationTube: return saturateTube(x);
+/**
+ * Saturation curve selected at compile time - the limiter kernels are
+ * instantiated once per SaturationMode
+ */
+template <int kMode>
+static inline float saturate(float x, const float* tanhTable) {
+    switch (kMode) {
+        case kSaturationTube: return saturateTube(x, tanhTable);
         case kSaturationHard: return saturateHard(x);
-        default: return saturateSoft(x);
+        default: return saturateSoft(x, tanhTable);
+    }
+}
+
+/**
+ * Lite clipper curve: linear up to kClipperKnee, then the saturation curve
+ * scaled into the rest of the way, so the output is continuous at the knee
+ * and reaches the same ceiling. Hard is already linear below 0.8 and is
+ * used as it is.
+ */
+template <int kMode>
+static inline float clip(float x, const float* tanhTable) {
+    const float span = 1.0f - kClipperKnee;
+    if (kMode == kSaturationHard) return saturateHard(x);
+    if (x > kClipperKnee) return kClipperKnee + span * saturate<kMode>((x - kClipperKnee) / span, tanhTable);
+    if (x < -kClipperKnee) return -kClipperKnee + span * saturate<kMode>((x + kClipperKnee) / span, tanhTable);
+    return x;
+}
+
+/**
+ * Halfband interpolation weights: the odd taps of a Kaiser-windowed halfband
+ * FIR, doubled, nearest the centre first. A is the 31-tap 1x <-> 2x stage
+ * (flat to 0.36 fs, about 58 dB down from 0.64 fs); B is the 7-tap 2x <-> 4x
+ * stage, which only has to handle a stream already band-limited by A.
+ */
+static const float halfbandA[kHalfbandTapsA] = {
+    0.631462257f, -0.196040742f, 0.101683787f, -0.0578285134f,
+    0.0325050989f, -0.0169690138f, 0.00761660131f, -0.00242947505f,
+};
+static const float halfbandB[kHalfbandTapsB] = { 0.593964527f, -0.0939645273f };
+
+/**
+ * Halfband 2x interpolator: dst[2i] = src[i - kTaps] and dst[2i + 1] is the
+ * midpoint between it and the next frame. Reads 2 * kTaps - 1 samples of
+ * history before src[0].
+ */
+template <int kTaps>
+static inline void halfbandUp(const float* src, float* dst, int n, const float* weights) {
+    for (int i = 0; i < n; ++i) {
+        const float* centre = src + i - kTaps;
+        float acc = 0.0f;
+        for (int k = 0; k < kTaps; ++k) {
+            acc += weights[k] * (centre[-k] + centre[k + 1]);
+        }
+        dst[2 * i] = centre[0];
+        dst[2 * i + 1] = acc;
+    }
+}
+
+/**
+ * Halfband 2x decimator, the inverse of halfbandUp(): dst[i] is centred on
+ * src[2i - 2 * kTaps]. Reads 4 * kTaps - 1 samples of history before src[0].
+ */
+template <int kTaps>
+static inline void halfbandDown(const float* src, float* dst, int n, const float* weights) {
+    for (int i = 0; i < n; ++i) {
+        const float* centre = src + 2 * i - 2 * kTaps;
+        float acc = centre[0];
+        for (int k = 0; k < kTaps; ++k) {
+            acc += weights[k] * (centre[-2 * k - 1] + centre[2 * k + 1]);
+        }
+        dst[i] = 0.5f * acc;
     }
 }
 
+/**
+ * Quarter-sine lookup - sin(x * π/2) for x in 0..1, linearly interpolated
+ */
+static inline float quarterSine(const float* table, float x) {
+    float pos = x * kPanTableSize;
+    int idx = (int)pos;
+    if (idx >= kPanTableSize) idx = kPanTableSize - 1;
+    float frac = pos - idx;
+    return table[idx] + frac * (table[idx + 1] - table[idx]);
+}
+
+/**
+ * Equal power panner using the quarter-sine table (control-rate path)
+ */
+static inline void tablePan(const float* table, float pan, float& gainL, float& gainR) {
+    float p = (pan + 100.0f) / 200.0f;
+    gainL = quarterSine(table, 1.0f - p);
+    gainR = quarterSine(table, p);
+}
+
 // ============================================================================
 // DATA STRUCTURES
 // ============================================================================
 
 /**
- * DTC memory - fast access for limiter state
+ * Power-of-two ring of samples. Positions are free-running counters wrapped
+ * with the mask, so a block read or write that crosses the end of the buffer
+ * splits into at most two runs. Consecutive samples are `stride` floats
+ * apart, which lets a ring be a view onto one lane of interleaved storage;
+ * contiguous rings (stride 1) copy blocks with memcpy.
+ */
+struct _seymourRing {
+    float* data;
+    uint32_t mask;      // frames - 1
+    uint32_t stride;
+
+    void init(float* data_, uint32_t frames, uint32_t stride_) {
+        data = data_;
+        mask = frames - 1;
+        stride = stride_;
+    }
+
+    uint32_t frames() const { return mask + 1; }
+
+    // Frames holding data after numFrames more are written, when `written`
+    // did before (see readWritten())
+    uint32_t addWritten(uint32_t written, uint32_t numFrames) const {
+        written += numFrames;
+        return written < frames() ? written : frames();
+    }
+
+    float& at(uint32_t pos) const { return data[(pos & mask) * stride]; }
+
+    // Copy numFrames samples from src into the ring, starting at pos
+    void write(uint32_t pos, const float* src, uint32_t numFrames) const {
+        uint32_t start = pos & mask;
+        uint32_t first = frames() - start;
+        if (first > numFrames) first = numFrames;
+        copyIn(start, src, first);
+        copyIn(0, src + first, numFrames - first);
+    }
+
+    // Copy numFrames samples starting at pos out of the ring into dst
+    void read(uint32_t pos, float* dst, uint32_t numFrames) const {
+        uint32_t start = pos & mask;
+        uint32_t first = frames() - start;
+        if (first > numFrames) first = numFrames;
+        copyOut(start, dst, first);
+        copyOut(0, dst + first, numFrames - first);
+    }
+
+    // read() from a ring in which only the `written` frames before writePos
+    // hold data since it was created or cleared; older frames read as zero.
+    // This lets a ring be cleared by resetting its count instead of its memory.
+    void readWritten(uint32_t pos, float* dst, uint32_t numFrames, uint32_t writePos, uint32_t written) const {
+        uint32_t age = writePos - pos;      // of the first frame read
+        if (age <= written) {
+            read(pos, dst, numFrames);
+            return;
+        }
+        uint32_t stale = age - written;
+        if (stale > numFrames) stale = numFrames;
+        memset(dst, 0, stale * sizeof(float));
+        read(pos + stale, dst + stale, numFrames - stale);
+    }
+
+private:
+    void copyIn(uint32_t index, const float* src, uint32_t count) const {
+        if (stride == 1) {
+            memcpy(data + index, src, count * sizeof(float));
+            return;
+        }
+        float* p = data + index * stride;
+        for (uint32_t i = 0; i < count; ++i, p += stride) {
+            *p = src[i];
+        }
+    }
+
+    void copyOut(uint32_t index, float* dst, uint32_t count) const {
+        if (stride == 1) {
+            memcpy(dst, data + index, count * sizeof(float));
+            return;
+        }
+        const float* p = data + index * stride;
+        for (uint32_t i = 0; i < count; ++i, p += stride) {
+            dst[i] = *p;
+        }
+    }
+};
+
+/**
+ * Sliding-window detector state (kDetectorWindow). The deque holds the
+ * required gain of each frame still in the window, increasing from head to
+ * tail, so the head is the window minimum; the boxcar sum averages that
+ * minimum over the same window.
+ */
+struct _seymourWindow {
+    uint32_t head;          // deque positions, free-running
+    uint32_t tail;
+    uint32_t length;        // boxcar length the sum was built for, 0 = rebuild
+    float sum;
+    float invLength;
+    bool active;            // false until the detector has been primed
+};
+
+/**
+ * A parameter's path across one chunk: a linear ramp from the value before
+ * the chunk to the value after it. A settled parameter has step 0 and the
+ * ramp is the constant `to`.
+ */
+struct _seymourRamp {
+    float from;
+    float step;     // per frame
+    float to;
+
+    float at(int i) const { return from + step * (i + 1); }
+};
+
+/**
+ * One-pole parameter smoother advanced a chunk at a time. The one-pole is
+ * evaluated at the chunk boundaries with the block coefficient and the chunk
+ * interpolates linearly between them; once within kSmootherSettleThreshold
+ * of the target it snaps there and the ramps become constants.
+ */
+struct _seymourSmoother {
+    float value;
+
+    _seymourRamp advance(float target, const float* blockCoeff, int numFrames) {
+        _seymourRamp ramp;
+        ramp.from = value;
+        if (value != target) {
+            value += blockCoeff[numFrames] * (target - value);
+            if (fabsf(target - value) < kSmootherSettleThreshold) value = target;
+        }
+        ramp.to = value;
+        ramp.step = (ramp.to - ramp.from) / numFrames;
+        return ramp;
+    }
+};
+
+// Lengths of the oversampler buffers in samples: each keeps the history its
+// filter reads in front of the current chunk
+enum {
+    kOversampleBaseFrames = kOversampleHistory + kBlockFrames,      // limited signal, threshold
+    kOversampleResidual2x = 4 * kHalfbandTapsA + 2 * kBlockFrames,
+    kOversampleResidual4x = 4 * kHalfbandTapsB + 4 * kBlockFrames,
+    kOversampleBlockUp = 2 * kHalfbandTapsB + 2 * kBlockFrames,
+};
+
+/**
+ * Oversampled saturation state for one side, in DTC after the lane scratch
+ * (see dtcLayout()); only the buffers the largest factor needs are there
+ */
+struct _seymourOversampler {
+    float* limited;         // base rate, after the limiter gain
+    float* threshold;       // per frame, 0 = not saturating
+    float* residual2x;      // saturated minus linear, at 2x
+    float* residual4x;      // the same at 4x, NULL below 4x
+};
+
+/**
+ * DTC memory - everything step() touches per frame: limiter and smoother
+ * state and the block scratch. The per-channel state, lane scratch, limiter
+ * and oversampler follow the struct, sized for the specifications (see
+ * dtcLayout()).
  */
 struct _seymourDTC {
-    float envelope;
-    float gainReduction;
-    uint32_t writeIndex;
+    float envelope[2];              // per detector side (see LinkMode); Linked uses side 0
+    float gainReduction[2];
+    int limiterLink;                // link mode the sides are set up for
+    uint32_t writeIndex;            // free-running ring positions
     uint32_t lookaheadSamples;
-    uint32_t bufferSize;
     uint32_t feedbackWriteIndex;
+    uint32_t lookaheadWritten;      // frames written since the rings were cleared,
+    uint32_t feedbackWritten;       // up to their length (see readWritten())
     uint32_t feedbackDelaySamples;
-    uint32_t feedbackBufferSize;
+    uint32_t sampleRate;            // rate the coefficients and delays are set for
     float dcBlockerCoeff;
     float envelopeAttack;
     float envelopeRelease;
     float smoothingCoeff;
     float gainSmoothingCoeff;
+    // smoothingCoeff applied once per block of n frames: 1 - (1 - c)^n
+    float controlSmoothingCoeff[kBlockFrames + 1];
+    // gainSmoothingCoeff likewise, per limiter gain update of n frames
+    float detectorGainCoeff[kDetectorFrames + 1];
+
+    // Global DSP state
+    _seymourSmoother masterLevelSmoothed;
+    _seymourSmoother cascadeSmoothed;
+    _seymourSmoother squashSmoothed;
+
+    // Block scratch - one chunk of the staged pipeline in step()
+    _seymourRamp levelRamp;
+    _seymourRamp thresholdRamp;     // limiter threshold in volts, from Squash
+    float blockChannel[kBlockFrames];
+    float blockTap[kBlockFrames];
+    float blockMixL[kBlockFrames];
+    float blockMixR[kBlockFrames];
+    float blockDelayedL[kBlockFrames];
+    float blockDelayedR[kBlockFrames];
+
+    // Oversampled saturation (see oversampleSaturation())
+    int oversampleFactor;                   // factor the oversampler is set up for, 1 = none
+    uint32_t oversampleTail;                // frames the decimators still have to run
+
+    // Last values written to the GR and Env CV outputs, in volts
+    float grOutput;
+    float envOutput;
+};
+
+/**
+ * DTC memory only the lookahead limiter touches - Full mode only, after the
+ * lane scratch
+ */
+struct _seymourLimiterDTC {
+    _seymourWindow window[2];               // per detector side
+    float blockDetect[2][kBlockFrames];     // detector input per side
+    float blockGain[2][kBlockFrames];       // limiter gain per side
+    float blockSaturate[2][kBlockFrames];   // saturation threshold per side, 0 = not saturating
+};
+
+// Per-channel fields stored after _seymourDTC: panSmoothed, panGainL,
+// panGainR, dcBlockerX1, dcBlockerY1, silentFrames and delaySmoothed
+enum { kChannelStateFields = 7 };
+
+/**
+ * Rows of lane scratch for numChannels channels: the Hadamard mix pads to a
+ * power of two (see mixTaps()) and the SIMD pass to whole vectors of four
+ */
+static inline int32_t laneRows(int32_t numChannels) {
+    int32_t rows = 1;
+    while (rows < numChannels) rows <<= 1;
+#if SEYMOUR_SIMD
+    int32_t vectors = (numChannels + 3) & ~3;
+    if (rows < vectors) rows = vectors;
+#endif
+    return rows;
+}
+
+/**
+ * Byte offsets of the DTC memory after _seymourDTC, shared by
+ * calculateRequirements() and construct()
+ */
+struct _seymourDTCLayout {
+    uint32_t channelState;  // kChannelStateFields arrays of numChannels entries
+    uint32_t blockLanes;    // laneRows() rows of per-channel taps, then results
+    uint32_t tapDelay;      // each lane's tap delay in frames over the chunk
+    uint32_t tapReach;      // how far back the chunk's taps read in each lane
+    uint32_t limiter;       // _seymourLimiterDTC, none in Lite
+    uint32_t oversampler;   // per side limited, threshold, residual2x (and residual4x), then blockUp
+    uint32_t bytes;         // total
+};
+
+/**
+ * Floats of oversampler state for the largest factor an instance runs at,
+ * 1 = none: 2x needs the 2x residual, 4x the 4x one and the 2x stream too
+ */
+static inline uint32_t oversamplerFloats(int maxOversample) {
+    if (maxOversample < 2) return 0;
+    uint32_t side = 2 * kOversampleBaseFrames + kOversampleResidual2x;
+    if (maxOversample < 4) return 2 * side;
+    return 2 * (side + kOversampleResidual4x) + kOversampleBlockUp;
+}
+
+static inline _seymourDTCLayout dtcLayout(int32_t numChannels, bool lite, int maxOversample) {
+    _seymourDTCLayout layout;
+    layout.channelState = sizeof(_seymourDTC);
+    layout.blockLanes = layout.channelState + kChannelStateFields * numChannels * sizeof(float);
+    layout.tapDelay = layout.blockLanes + laneRows(numChannels) * kBlockFrames * sizeof(float);
+    layout.tapReach = layout.tapDelay + numChannels * sizeof(_seymourRamp);
+    layout.limiter = layout.tapReach + numChannels * sizeof(uint32_t);
+    layout.oversampler = layout.limiter + (lite ? 0 : sizeof(_seymourLimiterDTC));
+    layout.bytes = layout.oversampler + oversamplerFloats(maxOversample) * sizeof(float);
+    return layout;
+}
+
+/**
+ * DTC bytes needed for numChannels channels in either mode, oversampling up
+ * to maxOversample
+ */
+static inline uint32_t dtcBytes(int32_t numChannels, bool lite, int maxOversample) {
+    return dtcLayout(numChannels, lite, maxOversample).bytes;
+}
+
+/**
+ * Per-channel control state - derived from the parameters in parameterChanged()
+ * so step() never has to decode parameter values itself
+ */
+struct _seymourChannelControl {
+    int inputBus;           // 0-based bus index, -1 = none
+    int panCVBus;           // 0-based bus index, -1 = none
+    float pan;              // -100..+100
+    float panGainL;         // equal power gains for pan
+    float panGainR;
+    float panCVDepth;       // 0..1
+    bool panCVConnected;
+    int delayCVBus;         // 0-based bus index, -1 = none
+    float delayScale;       // lane delay as a multiple of the global FB Delay, 0.25..2
+    float delayCVDepth;     // 0..1
+    bool delayCVConnected;
+};
+
+/**
+ * Global control state - derived from the parameters in parameterChanged()
+ */
+struct _seymourGlobalControl {
+    int outLBus;            // 0-based bus index
+    int outRBus;
+    int grOutBus;           // 0-based bus index, -1 = none
+    int envOutBus;
+    bool replaceL;
+    bool replaceR;
+    float masterLevel;      // 0..1
+    float cascade;          // 0..1.5
+    float squash;           // 0..1
+    int saturationMode;
+    int detector;
+    int topology;
+    int oversample;         // saturation oversampling factor, 1 = off
+    int link;
+};
+
+/**
+ * Cycle counter for SEYMOUR_INSTRUMENT builds
+ */
+#if SEYMOUR_INSTRUMENT
+static inline uint32_t cycleCount() {
+#if defined(__arm__)
+    return *(volatile uint32_t*)0xE0001004;         // DWT_CYCCNT
+#elif defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static inline void enableCycleCounter() {
+#if defined(__arm__)
+    *(volatile uint32_t*)0xE000EDFC |= 1u << 24;    // DEMCR.TRCENA
+    *(volatile uint32_t*)0xE0001000 |= 1u;          // DWT_CTRL.CYCCNTENA
+#endif
+}
+#endif
+
+// Stages timed in SEYMOUR_INSTRUMENT builds
+enum ProfileStage {
+    kStageMix,          // smoothing, input gather, pan/mix
+    kStageFeedback,     // taps, DC blockers, lane writes
+    kStageLimiter,      // level, lookahead, detector, saturation
+    kNumStages
+};
+
+/**
+ * Per-stage cycle split for one step() call. Without SEYMOUR_INSTRUMENT it is
+ * empty and every call compiles away.
+ */
+struct _seymourProfile {
+#if SEYMOUR_INSTRUMENT
+    uint32_t start;
+    uint32_t mark;
+    uint32_t stage[kNumStages];
+
+    _seymourProfile() : start(cycleCount()), mark(start) {
+        for (int s = 0; s < kNumStages; ++s) stage[s] = 0;
+    }
+    // Charge the cycles since the previous split to stage s
+    void split(int s) {
+        uint32_t now = cycleCount();
+        stage[s] += now - mark;
+        mark = now;
+    }
+#else
+    void split(int) {}
+#endif
+};
+
+#if SEYMOUR_INSTRUMENT
+/**
+ * step() cycle statistics, collected over a window of about a quarter of a
+ * second and published for draw() when the window closes
+ */
+struct _seymourCycleStats {
+    uint32_t steps;
+    uint32_t frames;
+    uint32_t minStep;
+    uint32_t maxStep;
+    uint64_t sumStep;
+    uint64_t sumStage[kNumStages];
+
+    // Last completed window
+    uint32_t shownMin;
+    uint32_t shownAvg;
+    uint32_t shownMax;
+    uint32_t shownStage[kNumStages];    // average per step
+    uint32_t shownPerFrame;             // average cycles per frame
+};
+#endif
+
+/**
+ * Read-only lookup tables, built once in initialise() and shared by every
+ * instance from the factory's static memory
+ */
+struct _seymourTables {
+    // sin(x * π/2) sampled over 0..1 for tablePan()
+    float panSine[kPanTableSize + 1];
+#if SEYMOUR_FAST_TANH == 2
+    // tanh(x) sampled over 0..kTanhTableRange for fastTanh()
+    float tanh[kTanhTableSize + 1];
+#endif
 };
 
+// Set up by initialise() before any instance is constructed
+static const _seymourTables* seymourTables = NULL;
+
+struct _seymourAlgorithm;
+
+// Processing kernel for one host block (see stepKernels)
+typedef void (*_seymourKernel)(_seymourAlgorithm* pThis, float* busFrames, int numFramesBy4);
+
 /**
  * Main algorithm structure - contains parameter storage
  */
 struct _seymourAlgorithm : public _NT_algorithm
 {
-    _seymourAlgorithm(int32_t numChannels_);
+    _seymourAlgorithm(int32_t numChannels_, int32_t maxDelayMs, bool lite_, int maxOversample_, bool windowDetector_);
     ~_seymourAlgorithm() {}
 
     // Configuration
     int32_t numChannels;
+    bool lite;                  // Lite mode: feed-forward clipper, no lookahead line
+    int maxOversample;          // largest oversampling factor the DTC has room for, 1 = none
+    bool windowDetector;        // DRAM has the Window detector's lines
+    _seymourKernel kernel;      // chosen in construct() for numChannels and the mode
 
     // Memory pointers
     _seymourDTC* dtc;
-    float* lookaheadBuffer;
-    float* feedbackDelayBuffer;
-
-    // Per-channel DSP state
-    float panSmoothed[kMaxChannels];
-    float dcBlockerX1[kMaxChannels];
-    float dcBlockerY1[kMaxChannels];
-
-    // Global DSP state
-    float masterLevelSmoothed;
-    float cascadeSmoothed;
-    float squashSmoothed;
+    _seymourLimiterDTC* limiter;        // in DTC after the lane scratch, NULL in Lite
+    _seymourRing lookaheadBuffer[2];    // L, R
+    _seymourRing windowMinGain[2];      // window minimum per frame, for the boxcar, per side
+    float* windowDequeGain[2];          // deque storage, one lookahead line long
+    uint32_t* windowDequePos[2];
+    _seymourRing feedbackDelayBuffer[kMaxChannels]; // one lane per channel (see SEYMOUR_FEEDBACK_SOA)
+
+    // Control state (see parameterChanged)
+    _seymourChannelControl channelControl[kMaxChannels];
+    _seymourGlobalControl globalControl;
+
+    // Per-channel DSP state, numChannels entries each in DTC after _seymourDTC
+    float* panSmoothed;
+    float* panGainL;                    // gains reached at the end of the last block
+    float* panGainR;
+    float* dcBlockerX1;
+    float* dcBlockerY1;
+    uint32_t* silentFrames;             // frames of silence at the end of each feedback lane
+    float* delaySmoothed;               // tap delay of each lane in frames, CV smoothed
+    float (*blockLanes)[kBlockFrames];  // lane scratch, laneRows() rows (see mixTaps())
+    _seymourRamp* tapDelay;             // see updateTapDelays()
+    uint32_t* tapReach;
+    _seymourOversampler oversampler[2];     // L, R
+    float* blockUp;                     // 2x stream feeding the 4x stage, NULL below 4x
+    bool feedbackStale;                 // lanes and DC blockers still hold pre-mixer history
+
+    // Shared tables (see _seymourTables)
+    const float* panSineTable;
+#if SEYMOUR_FAST_TANH == 2
+    const float* tanhTable;
+#endif
+
+#if SEYMOUR_INSTRUMENT
+    _seymourCycleStats cycles;
+#endif
 
     // Parameter storage - INSIDE the struct (key difference!)
-    _NT_parameter       parameterDefs[kMaxChannels * kNumPerChannelParameters + kNumGlobalParameters];
+    _NT_parameter       parameterDefs[kMaxChannels * (kNumPerChannelParameters + kNumPerChannelDelayParameters)
+                                      + kNumGlobalParameters];
     _NT_parameterPages  pagesDefs;
     _NT_parameterPage   pageDefs[kMaxChannels + 2];  // +2 for Seymour + Routing pages
-    uint8_t             channelPageParams[kMaxChannels][kNumPerChannelParameters];
-    uint8_t             seymourPageParams[6];  // Level, Cascade, Lookahead, Saturation, FB Delay, Squash
-    uint8_t             routingPageParams[4];
+    uint8_t             channelPageParams[kMaxChannels][kNumPerChannelParameters + kNumPerChannelDelayParameters];
+    uint8_t             seymourPageParams[10]; // Level, Cascade, Lookahead, Saturation, FB Delay, Squash, Detector, Topology, Oversample, Link
+    uint8_t             routingPageParams[6];
 };
 
+/**
+ * Decode one parameter value into the control state read by step()
+ */
+static void updateControl(_seymourAlgorithm* pThis, int p, int value) {
+    int globalBase = pThis->numChannels * kNumPerChannelParameters;
+    int delayBase = globalBase + kNumGlobalParameters;
+
+    if (p < globalBase) {
+        _seymourChannelControl& cc = pThis->channelControl[p / kNumPerChannelParameters];
+        switch (p % kNumPerChannelParameters) {
+            case kChParamInput:
+                cc.inputBus = value - 1;
+                break;
+            case kChParamPan:
+                cc.pan = (float)value;
+                equalPowerPan(cc.pan, cc.panGainL, cc.panGainR);
+                break;
+            case kChParamPanCV:
+                cc.panCVBus = value - 1;
+                cc.panCVConnected = cc.panCVBus >= 0;
+                break;
+            case kChParamPanCVDepth:
+                cc.panCVDepth = value / 100.0f;
+                break;
+        }
+        return;
+    }
+
+    if (p >= delayBase) {
+        _seymourChannelControl& cc = pThis->channelControl[(p - delayBase) / kNumPerChannelDelayParameters];
+        switch ((p - delayBase) % kNumPerChannelDelayParameters) {
+            case kChParamDelay:
+                cc.delayScale = value / 100.0f;
+                break;
+            case kChParamDelayCV:
+                cc.delayCVBus = value - 1;
+                cc.delayCVConnected = cc.delayCVBus >= 0;
+                break;
+            case kChParamDelayCVDepth:
+                cc.delayCVDepth = value / 100.0f;
+                break;
+        }
+        return;
+    }
+
+    _seymourGlobalControl& gc = pThis->globalControl;
+    switch (p - globalBase) {
+        case kParamOutputL:
+            gc.outLBus = value - 1;
+            break;
+        case kParamOutputLMode:
+            gc.replaceL = value;
+            break;
+        case kParamOutputR:
+            gc.outRBus = value - 1;
+            break;
+        case kParamOutputRMode:
+            gc.replaceR = value;
+            break;
+        case kParamGROutput:
+            gc.grOutBus = value - 1;
+            break;
+        case kParamEnvOutput:
+            gc.envOutBus = value - 1;
+            break;
+        case kParamMasterLevel:
+            gc.masterLevel = value / 100.0f;
+            break;
+        case kParamCascade:
+            gc.cascade = value / 100.0f;  // 0-1.5 (150%)
+            break;
+        case kParamSaturation:
+            gc.saturationMode = value;
+            break;
+        case kParamDetector:
+            gc.detector = pThis->windowDetector ? value : kDetectorEnvelope;
+            break;
+        case kParamTopology:
+            gc.topology = value;
+            break;
+        case kParamOversample:
+            gc.oversample = 1 << value;
+            if (gc.oversample > pThis->maxOversample) gc.oversample = pThis->maxOversample;
+            break;
+        case kParamLink:
+            gc.link = value;
+            break;
+        case kParamSquash:
+            gc.squash = value / 100.0f;
+            if (gc.squash < 0.0f) gc.squash = 0.0f;
+            if (gc.squash > 1.0f) gc.squash = 1.0f;
+            break;
+    }
+}
+
 /**
  * Constructor - builds parameters dynamically based on numChannels
  */
-_seymourAlgorithm::_seymourAlgorithm(int32_t numChannels_)
-    : numChannels(numChannels_)
+_seymourAlgorithm::_seymourAlgorithm(int32_t numChannels_, int32_t maxDelayMs, bool lite_, int maxOversample_,
+                                     bool windowDetector_)
+    : numChannels(numChannels_), lite(lite_), maxOversample(maxOversample_), windowDetector(windowDetector_)
 {
-    // Initialize DSP state
-    for (int i = 0; i < kMaxChannels; ++i) {
-        panSmoothed[i] = 0.0f;
-        dcBlockerX1[i] = 0.0f;
-        dcBlockerY1[i] = 0.0f;
-    }
-    masterLevelSmoothed = 1.0f;
-    cascadeSmoothed = 0.0f;  // Default 0% (no feedback)
-    squashSmoothed = 0.56f;  // Default 56%
+    panSineTable = seymourTables->panSine;
+#if SEYMOUR_FAST_TANH == 2
+    tanhTable = seymourTables->tanh;
+#endif
 
-    // Build per-channel parameters
+    // Build per-channel parameters: the original block up front and the
+    // delay block after the globals, both on the channel's page
+    int globalBase = numChannels * kNumPerChannelParameters;
+    int delayBase = globalBase + kNumGlobalParameters;
     for (int32_t ch = 0; ch < numChannels; ++ch) {
         int baseIdx = ch * kNumPerChannelParameters;
+        int delayIdx = delayBase + ch * kNumPerChannelDelayParameters;
 
         // Copy per-channel parameter templates
         memcpy(parameterDefs + baseIdx, perChannelParameters,
                kNumPerChannelParameters * sizeof(_NT_parameter));
+        memcpy(parameterDefs + delayIdx, perChannelDelayParameters,
+               kNumPerChannelDelayParameters * sizeof(_NT_parameter));
 
         // Set default input to sequential busses
         parameterDefs[baseIdx + kChParamInput].def = ch + 1;
 
         // Build channel page
         pageDefs[ch].name = channelPageNames[ch];
-        pageDefs[ch].numParams = kNumPerChannelParameters;
+        pageDefs[ch].numParams = kNumPerChannelParameters + kNumPerChannelDelayParameters;
         pageDefs[ch].params = channelPageParams[ch];
 
         for (int p = 0; p < kNumPerChannelParameters; ++p) {
             channelPageParams[ch][p] = baseIdx + p;
         }
+        for (int p = 0; p < kNumPerChannelDelayParameters; ++p) {
+            channelPageParams[ch][kNumPerChannelParameters + p] = delayIdx + p;
+        }
     }
 
-    // Add global parameters at the end
-    int globalBase = numChannels * kNumPerChannelParameters;
+    // Add global parameters after the per-channel block
     memcpy(parameterDefs + globalBase, globalParameters,
            kNumGlobalParameters * sizeof(_NT_parameter));
     // Default both output modes to Add
     parameterDefs[globalBase + kParamOutputLMode].def = 0;
     parameterDefs[globalBase + kParamOutputRMode].def = 0;
 
-    // Build Seymour (algorithm-global) page
+    // Limit the delay times to what the buffers were sized for
+    const int delayParams[] = { kParamLookahead, kParamFeedbackDelay };
+    for (unsigned i = 0; i < ARRAY_SIZE(delayParams); ++i) {
+        _NT_parameter& param = parameterDefs[globalBase + delayParams[i]];
+        param.max = maxDelayMs * 10;
+        if (param.def > param.max) param.def = param.max;
+    }
+
+    // Limit oversampling to the factors the DTC was sized for
+    _NT_parameter& oversampleParam = parameterDefs[globalBase + kParamOversample];
+    oversampleParam.max = maxOversample == 4 ? 2 : maxOversample == 2 ? 1 : 0;
+    if (oversampleParam.def > oversampleParam.max) oversampleParam.def = oversampleParam.max;
+
+    // Likewise the detectors to the ones DRAM was sized for
+    _NT_parameter& detectorParam = parameterDefs[globalBase + kParamDetector];
+    detectorParam.max = windowDetector ? kDetectorWindow : kDetectorEnvelope;
+    if (detectorParam.def > detectorParam.max) detectorParam.def = detectorParam.max;
+
+    // Build Seymour (algorithm-global) page. The Lite clipper has no
+    // lookahead, detector or link, so those stay off it, and the detector
+    // choice and oversampling only appear when there is room for them.
+    const int seymourParams[] = {
+        kParamMasterLevel, kParamCascade, kParamLookahead, kParamSaturation, kParamFeedbackDelay,
+        kParamSquash, kParamDetector, kParamTopology, kParamOversample, kParamLink,
+    };
+    int numSeymourParams = 0;
+    for (unsigned i = 0; i < ARRAY_SIZE(seymourParams); ++i) {
+        int param = seymourParams[i];
+        if (lite && (param == kParamLookahead || param == kParamLink)) continue;
+        if (param == kParamDetector && !windowDetector) continue;
+        if (param == kParamOversample && maxOversample == 1) continue;
+        seymourPageParams[numSeymourParams++] = globalBase + param;
+    }
     pageDefs[numChannels].name = "Seymour";
-    pageDefs[numChannels].numParams = ARRAY_SIZE(seymourPageParams);
+    pageDefs[numChannels].numParams = numSeymourParams;
     pageDefs[numChannels].params = seymourPageParams;
-    seymourPageParams[0] = globalBase + kParamMasterLevel;
-    seymourPageParams[1] = globalBase + kParamCascade;
-    seymourPageParams[2] = globalBase + kParamLookahead;
-    seymourPageParams[3] = globalBase + kParamSaturation;
-    seymourPageParams[4] = globalBase + kParamFeedbackDelay;
-    seymourPageParams[5] = globalBase + kParamSquash;
 
     // Build routing page (I/O and output mode)
     pageDefs[numChannels + 1].name = "Routing";
-    pageDefs[numChannels + 1].numParams = ARRAY_SIZE(routingPageParams);
+    pageDefs[numChannels + 1].numParams = lite ? 4 : 6;     // Lite has no limiter state to send
     pageDefs[numChannels + 1].params = routingPageParams;
     routingPageParams[0] = globalBase + kParamOutputL;
     routingPageParams[1] = globalBase + kParamOutputLMode;
     routingPageParams[2] = globalBase + kParamOutputR;
     routingPageParams[3] = globalBase + kParamOutputRMode;
+    routingPageParams[4] = globalBase + kParamGROutput;
+    routingPageParams[5] = globalBase + kParamEnvOutput;
 
     // Setup pages structure
     pagesDefs.numPages = numChannels + 2;
@@ -312,75 +1236,275 @@ _seymourAlgorithm::_seymourAlgorithm(int32_t numChannels_)
     // Set _NT_algorithm members
     parameters = parameterDefs;
     parameterPages = &pagesDefs;
+
+    // Derive control state from the defaults until the host reports the real values
+    for (int p = 0; p < numParameters(numChannels); ++p) {
+        updateControl(this, p, parameterDefs[p].def);
+    }
 }
 
 // ============================================================================
 // SPECIFICATIONS
 // ============================================================================
 
+enum {
+    kSpecInputs,
+    kSpecMaxDelay,
+    kSpecLite,          // 0 = Full, 1 = Lite
+    kSpecOversample,    // largest Oversample setting: 0 = Off, 1 = 2x, 2 = 4x
+    kSpecWindow,        // 1 = offer the Window detector
+};
+
 static const _NT_specification specifications[] = {
     { .name = "Inputs", .min = 1, .max = kMaxChannels, .def = 2, .type = kNT_typeGeneric },
+    { .name = "Max delay (ms)", .min = 1, .max = kMaxDelayMs, .def = kMaxDelayMs, .type = kNT_typeGeneric },
+    { .name = "Lite", .min = 0, .max = 1, .def = 0, .type = kNT_typeGeneric },
+    { .name = "Max oversample", .min = 0, .max = 2, .def = 0, .type = kNT_typeGeneric },
+    { .name = "Window detector", .min = 0, .max = 1, .def = 0, .type = kNT_typeGeneric },
 };
 
+/**
+ * Delay line length for the "Max delay" specification at the current sample
+ * rate. Rounded up to a power of two with room for a whole chunk beyond the
+ * longest delay, so writing a chunk never overwrites frames it still reads.
+ */
+static uint32_t delayBufferFrames(int32_t maxDelayMs) {
+    uint32_t needed = (uint32_t)ceilf(NT_globals.sampleRate * (float)maxDelayMs / 1000.0f) + kBlockFrames;
+    uint32_t frames = 1;
+    while (frames < needed) frames <<= 1;
+    return frames;
+}
+
+/**
+ * Longest delay a ring can serve to chunked processing
+ */
+static inline uint32_t maxDelayFrames(const _seymourRing& ring) {
+    return ring.frames() - kBlockFrames;
+}
+
+/**
+ * Largest oversampling factor the specifications leave room for, 1 = none;
+ * the Lite clipper never oversamples
+ */
+static inline int maxOversampleFactor(const int32_t* specs) {
+    return specs[kSpecLite] ? 1 : 1 << specs[kSpecOversample];
+}
+
+/**
+ * Whether the specifications leave room for the Window detector's lines;
+ * the Lite clipper has no detector
+ */
+static inline bool hasWindowDetector(const int32_t* specs) {
+    return !specs[kSpecLite] && specs[kSpecWindow];
+}
+
 // ============================================================================
 // FACTORY FUNCTIONS
 // ============================================================================
 
+void calculateStaticRequirements(_NT_staticRequirements& req) {
+    req.dram = sizeof(_seymourTables);
+}
+
+void initialise(_NT_staticMemoryPtrs& ptrs, const _NT_staticRequirements& req) {
+    _seymourTables* tables = (_seymourTables*)ptrs.dram;
+    for (int i = 0; i <= kPanTableSize; ++i) {
+        tables->panSine[i] = sinf(i * 1.5707963f / kPanTableSize);
+    }
+#if SEYMOUR_FAST_TANH == 2
+    for (int i = 0; i <= kTanhTableSize; ++i) {
+        tables->tanh[i] = tanhf((float)i / kTanhTableStepsPerUnit);
+    }
+#endif
+    seymourTables = tables;
+}
+
 void calculateRequirements(_NT_algorithmRequirements& req, const int32_t* specs) {
-    int32_t numChannels = specs[0];
+    int32_t numChannels = specs[kSpecInputs];
+    uint32_t bufferFrames = delayBufferFrames(specs[kSpecMaxDelay]);
 
-    req.numParameters = numChannels * kNumPerChannelParameters + kNumGlobalParameters;
+    req.numParameters = numParameters(numChannels);
     req.sram = sizeof(_seymourAlgorithm);
-    req.dram = (kMaxLookaheadSamples * 2 + kMaxFeedbackDelaySamples * kMaxChannels) * sizeof(float);
-    req.dtc = sizeof(_seymourDTC);
+    // Stereo lookahead line, a window detector per side if offered (minimum
+    // ring, deque gain and position) and one feedback lane per channel; Lite
+    // only has the lanes
+    uint32_t limiterLines = specs[kSpecLite] ? 0 : 2 + (hasWindowDetector(specs) ? 2 * 3 : 0);
+    req.dram = bufferFrames * (limiterLines + numChannels) * sizeof(float);
+    req.dtc = dtcBytes(numChannels, specs[kSpecLite] != 0, maxOversampleFactor(specs));
     req.itc = 0;
 }
 
+static _seymourKernel selectKernel(int32_t numChannels, bool lite);
+
+/**
+ * Coefficients that depend on the sample rate, for the current system rate
+ */
+static void setRateCoefficients(_seymourDTC* dtc) {
+    float sr = NT_globals.sampleRate;
+    dtc->sampleRate = NT_globals.sampleRate;
+    dtc->dcBlockerCoeff = 1.0f - (6.28318f * 5.0f / sr);
+    dtc->smoothingCoeff = 1.0f - expf(-6.28318f * 50.0f / sr);
+    dtc->envelopeAttack = 1.0f - expf(-6.28318f * 1000.0f / sr);
+    dtc->envelopeRelease = 1.0f - expf(-6.28318f * 50.0f / sr);
+    dtc->gainSmoothingCoeff = 1.0f - expf(-6.28318f * 30.0f / sr);
+    for (int n = 0; n <= kBlockFrames; ++n) {
+        dtc->controlSmoothingCoeff[n] = 1.0f - powf(1.0f - dtc->smoothingCoeff, (float)n);
+    }
+    for (int n = 0; n <= kDetectorFrames; ++n) {
+        dtc->detectorGainCoeff[n] = 1.0f - powf(1.0f - dtc->gainSmoothingCoeff, (float)n);
+    }
+}
+
+/**
+ * A delay time parameter value (0.1ms steps) in frames at the current rate,
+ * limited to what the ring can serve
+ */
+static uint32_t delayParameterFrames(int value, const _seymourRing& ring) {
+    float delayMs = value / 10.0f;
+    uint32_t samples = (uint32_t)(NT_globals.sampleRate * delayMs / 1000.0f);
+    if (samples > maxDelayFrames(ring)) samples = maxDelayFrames(ring);
+    if (samples < 1) samples = 1;
+    return samples;
+}
+
 _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs,
                          const _NT_algorithmRequirements& req,
                          const int32_t* specs) {
-    int32_t numChannels = specs[0];
+    int32_t numChannels = specs[kSpecInputs];
+    uint32_t bufferFrames = delayBufferFrames(specs[kSpecMaxDelay]);
+    bool lite = specs[kSpecLite] != 0;
+    int maxOversample = maxOversampleFactor(specs);
+    bool windowDetector = hasWindowDetector(specs);
 
     // Create algorithm with constructor that builds parameters
-    _seymourAlgorithm* alg = new (ptrs.sram) _seymourAlgorithm(numChannels);
+    _seymourAlgorithm* alg = new (ptrs.sram) _seymourAlgorithm(numChannels, specs[kSpecMaxDelay], lite, maxOversample,
+                                                               windowDetector);
+    alg->kernel = selectKernel(numChannels, lite);
 
     // Setup DTC
     alg->dtc = (_seymourDTC*)ptrs.dtc;
     _seymourDTC* dtc = alg->dtc;
 
-    dtc->envelope = 0.0f;
-    dtc->gainReduction = 1.0f;
+    for (int side = 0; side < 2; ++side) {
+        dtc->envelope[side] = 0.0f;
+        dtc->gainReduction[side] = 1.0f;
+    }
+    dtc->limiterLink = kLinkLinked;
     dtc->writeIndex = 0;
-    dtc->bufferSize = kMaxLookaheadSamples;
     dtc->feedbackWriteIndex = 0;
-    dtc->feedbackBufferSize = kMaxFeedbackDelaySamples;
+    dtc->lookaheadWritten = 0;
+    dtc->feedbackWritten = 0;
+    dtc->oversampleFactor = 1;
+    dtc->grOutput = 0.0f;
+    dtc->envOutput = 0.0f;
+    dtc->masterLevelSmoothed.value = 1.0f;
+    dtc->cascadeSmoothed.value = 0.0f;  // Default 0% (no feedback)
+    dtc->squashSmoothed.value = 0.56f;  // Default 56%
+
+    // Per-channel state, lane scratch, limiter and oversampler
+    _seymourDTCLayout layout = dtcLayout(numChannels, lite, maxOversample);
+    uint8_t* dtcBase = (uint8_t*)ptrs.dtc;
+    float* channelState = (float*)(dtcBase + layout.channelState);
+    alg->panSmoothed = channelState;
+    alg->panGainL = channelState + numChannels;
+    alg->panGainR = channelState + numChannels * 2;
+    alg->dcBlockerX1 = channelState + numChannels * 3;
+    alg->dcBlockerY1 = channelState + numChannels * 4;
+    alg->silentFrames = (uint32_t*)(channelState + numChannels * 5);
+    alg->delaySmoothed = channelState + numChannels * 6;
+    alg->blockLanes = (float (*)[kBlockFrames])(dtcBase + layout.blockLanes);
+    alg->tapDelay = (_seymourRamp*)(dtcBase + layout.tapDelay);
+    alg->tapReach = (uint32_t*)(dtcBase + layout.tapReach);
+    alg->limiter = lite ? NULL : (_seymourLimiterDTC*)(dtcBase + layout.limiter);
+    if (alg->limiter) {
+        alg->limiter->window[0].active = false;
+        alg->limiter->window[1].active = false;
+    }
+    float* oversampleState = (float*)(dtcBase + layout.oversampler);
+    for (int side = 0; side < 2; ++side) {
+        _seymourOversampler& os = alg->oversampler[side];
+        os.limited = os.threshold = os.residual2x = os.residual4x = NULL;
+        if (maxOversample < 2) continue;
+        os.limited = oversampleState;
+        os.threshold = os.limited + kOversampleBaseFrames;
+        os.residual2x = os.threshold + kOversampleBaseFrames;
+        oversampleState = os.residual2x + kOversampleResidual2x;
+        if (maxOversample < 4) continue;
+        os.residual4x = oversampleState;
+        oversampleState = os.residual4x + kOversampleResidual4x;
+    }
+    alg->blockUp = maxOversample == 4 ? oversampleState : NULL;
+    float centreGain = cosf(0.25f * 3.14159265f);
+    for (int32_t ch = 0; ch < numChannels; ++ch) {
+        alg->panSmoothed[ch] = 0.0f;
+        alg->panGainL[ch] = centreGain;
+        alg->panGainR[ch] = centreGain;
+        alg->dcBlockerX1[ch] = 0.0f;
+        alg->dcBlockerY1[ch] = 0.0f;
+    }
 
     // Precompute coefficients
     float sr = NT_globals.sampleRate;
-    dtc->dcBlockerCoeff = 1.0f - (6.28318f * 5.0f / sr);
-    dtc->smoothingCoeff = 1.0f - expf(-6.28318f * 50.0f / sr);
-    dtc->envelopeAttack = 1.0f - expf(-6.28318f * 1000.0f / sr);
-    dtc->envelopeRelease = 1.0f - expf(-6.28318f * 50.0f / sr);
-    dtc->gainSmoothingCoeff = 1.0f - expf(-6.28318f * 30.0f / sr);
+    setRateCoefficients(dtc);
     dtc->lookaheadSamples = (uint32_t)(sr * 0.005f);  // 5ms default
     dtc->feedbackDelaySamples = (uint32_t)(sr * 0.005f);  // 5ms default
+    if (dtc->lookaheadSamples > bufferFrames - kBlockFrames) dtc->lookaheadSamples = bufferFrames - kBlockFrames;
+    if (dtc->feedbackDelaySamples > bufferFrames - kBlockFrames) dtc->feedbackDelaySamples = bufferFrames - kBlockFrames;
+    for (int32_t ch = 0; ch < numChannels; ++ch) {
+        alg->delaySmoothed[ch] = (float)dtc->feedbackDelaySamples;
+    }
+
+    // Setup the delay lines. Nothing is cleared here: the lookahead and
+    // feedback rings read zero until written (see readWritten()), and the
+    // window detector fills its own storage when it is first primed. Lite
+    // has neither, and its DRAM starts with the feedback lanes; without the
+    // Window detector they follow the lookahead line.
+    float* dram = (float*)ptrs.dram;
+    float* feedbackBase = dram;
+    if (!lite) {
+        alg->lookaheadBuffer[0].init(dram, bufferFrames, 1);
+        alg->lookaheadBuffer[1].init(dram + bufferFrames, bufferFrames, 1);
+        feedbackBase = dram + bufferFrames * 2;
+    }
+    for (int side = 0; side < 2; ++side) {
+        alg->windowDequeGain[side] = NULL;
+        alg->windowDequePos[side] = NULL;
+        if (!windowDetector) continue;
+        float* window = feedbackBase;
+        alg->windowMinGain[side].init(window, bufferFrames, 1);
+        alg->windowDequeGain[side] = window + bufferFrames;
+        alg->windowDequePos[side] = (uint32_t*)(window + bufferFrames * 2);
+        feedbackBase = window + bufferFrames * 3;
+    }
+    // Idle channels still write their lanes until the whole ring holds data
+    for (int32_t ch = 0; ch < numChannels; ++ch) {
+        alg->silentFrames[ch] = 0;
+    }
+    alg->feedbackStale = false;
+#if SEYMOUR_INSTRUMENT
+    memset(&alg->cycles, 0, sizeof(alg->cycles));
+    alg->cycles.minStep = 0xFFFFFFFFu;
+    enableCycleCounter();
+#endif
+    for (int32_t ch = 0; ch < numChannels; ++ch) {
+#if SEYMOUR_FEEDBACK_SOA
+        alg->feedbackDelayBuffer[ch].init(feedbackBase + ch * bufferFrames, bufferFrames, 1);
+#else
+        alg->feedbackDelayBuffer[ch].init(feedbackBase + ch, bufferFrames, numChannels);
+#endif
+    }
 
-    // Setup lookahead buffer
-    alg->lookaheadBuffer = (float*)ptrs.dram;
-    memset(alg->lookaheadBuffer, 0, kMaxLookaheadSamples * 2 * sizeof(float));
-    alg->feedbackDelayBuffer = (float*)(ptrs.dram) + kMaxLookaheadSamples * 2;
-    memset(alg->feedbackDelayBuffer, 0, kMaxFeedbackDelaySamples * kMaxChannels * sizeof(float));
-
     return alg;
 }
 
 int parameterUiPrefix(_NT_algorithm* self, int p, char* buff) {
     _seymourAlgorithm* pThis = (_seymourAlgorithm*)self;
     int globalBase = pThis->numChannels * kNumPerChannelParameters;
+    int delayBase = globalBase + kNumGlobalParameters;
 
     // Only add prefix for per-channel parameters
-    if (p < globalBase) {
-        int ch = p / kNumPerChannelParameters;
+    if (p < globalBase || p >= delayBase) {
+        int ch = p < globalBase ? p / kNumPerChannelParameters : (p - delayBase) / kNumPerChannelDelayParameters;
         int len = NT_intToString(buff, 1 + ch);
         buff[len++] = ':';
         buff[len] = 0;
@@ -394,172 +1518,1972 @@ void parameterChanged(_NT_algorithm* self, int p) {
     _seymourDTC* dtc = pThis->dtc;
     int globalBase = pThis->numChannels * kNumPerChannelParameters;
 
-    // Check if lookahead changed
-    if (p == globalBase + kParamLookahead) {
-        float lookaheadMs = pThis->v[p] / 10.0f;
-        uint32_t samples = (uint32_t)(NT_globals.sampleRate * lookaheadMs / 1000.0f);
-        if (samples > dtc->bufferSize) samples = dtc->bufferSize;
-        if (samples < 1) samples = 1;
-        dtc->lookaheadSamples = samples;
+    updateControl(pThis, p, pThis->v[p]);
+
+    // Check if lookahead changed (Lite has no lookahead line)
+    if (p == globalBase + kParamLookahead && !pThis->lite) {
+        dtc->lookaheadSamples = delayParameterFrames(pThis->v[p], pThis->lookaheadBuffer[0]);
     } else if (p == globalBase + kParamFeedbackDelay) {
-        float delayMs = pThis->v[p] / 10.0f;
-        uint32_t samples = (uint32_t)(NT_globals.sampleRate * delayMs / 1000.0f);
-        if (samples >= dtc->feedbackBufferSize) samples = dtc->feedbackBufferSize - 1;
-        if (samples < 1) samples = 1;
-        dtc->feedbackDelaySamples = samples;
+        dtc->feedbackDelaySamples = delayParameterFrames(pThis->v[p], pThis->feedbackDelayBuffer[0]);
     }
 }
 
-void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
-    _seymourAlgorithm* pThis = (_seymourAlgorithm*)self;
+/**
+ * Advance channel ch's pan smoother over the m frames of panCV (NULL without
+ * CV) and return the gains it reaches at the end of them
+ */
+static inline void panControlPoint(const _seymourAlgorithm* pThis, int ch, const float* panCV, int m,
+                                   float& panSmoothed, float& nextL, float& nextR) {
+    const _seymourChannelControl& cc = pThis->channelControl[ch];
+
+    float panTarget = cc.pan;
+    if (panCV) {
+        float cvSum = 0.0f;
+        for (int i = 0; i < m; ++i) {
+            cvSum += panCV[i];
+        }
+        float cv = cvSum / (m * 5.0f);
+        panTarget += cv * 100.0f * cc.panCVDepth;
+        if (panTarget < -100.0f) panTarget = -100.0f;
+        if (panTarget > 100.0f) panTarget = 100.0f;
+    }
+
+    // Smooth pan (one-pole, advanced by m frames at once)
+    panSmoothed += pThis->dtc->controlSmoothingCoeff[m] * (panTarget - panSmoothed);
+
+    if (!panCV && fabsf(panTarget - panSmoothed) < kPanSettleThreshold) {
+        panSmoothed = panTarget;
+        nextL = cc.panGainL;
+        nextR = cc.panGainR;
+    } else {
+        tablePan(pThis->panSineTable, panSmoothed, nextL, nextR);
+    }
+}
+
+/**
+ * Pan/mix pass - accumulates one channel of the chunk into the mix scratch.
+ * A settled pan without CV uses the gains precomputed in parameterChanged();
+ * otherwise the pan is smoothed at control rate and the gains are ramped
+ * linearly between control points.
+ */
+static void panAndMix(_seymourAlgorithm* pThis, int ch, const float* input, const float* panCV, int numFrames) {
+    const _seymourChannelControl& cc = pThis->channelControl[ch];
+    float* mixL = pThis->dtc->blockMixL;
+    float* mixR = pThis->dtc->blockMixR;
+
+    float gainL = pThis->panGainL[ch];
+    float gainR = pThis->panGainR[ch];
+
+    if (!panCV && pThis->panSmoothed[ch] == cc.pan) {
+        for (int i = 0; i < numFrames; ++i) {
+            mixL[i] += input[i] * gainL;
+            mixR[i] += input[i] * gainR;
+        }
+        return;
+    }
+
+    float panSmoothed = pThis->panSmoothed[ch];
+
+    for (int start = 0; start < numFrames; start += kControlFrames) {
+        int m = numFrames - start;
+        if (m > kControlFrames) m = kControlFrames;
+
+        float nextL, nextR;
+        panControlPoint(pThis, ch, panCV ? panCV + start : NULL, m, panSmoothed, nextL, nextR);
+
+        // Ramp the gains to the new control point
+        float stepL = (nextL - gainL) / m;
+        float stepR = (nextR - gainR) / m;
+        for (int i = start; i < start + m; ++i) {
+            gainL += stepL;
+            gainR += stepR;
+            mixL[i] += input[i] * gainL;
+            mixR[i] += input[i] * gainR;
+        }
+        gainL = nextL;
+        gainR = nextR;
+    }
+
+    pThis->panSmoothed[ch] = panSmoothed;
+    pThis->panGainL[ch] = gainL;
+    pThis->panGainR[ch] = gainR;
+}
+
+/**
+ * Reset one side's sliding-window detector to an empty, unity-gain window
+ */
+static void primeWindow(_seymourAlgorithm* pThis, int side) {
+    _seymourWindow& w = pThis->limiter->window[side];
+    const _seymourRing& minGain = pThis->windowMinGain[side];
+    for (uint32_t i = 0; i < minGain.frames(); ++i) {
+        minGain.data[i] = 1.0f;
+    }
+    w.head = 0;
+    w.tail = 0;
+    w.length = 0;
+    w.active = true;
+}
+
+/**
+ * Sliding-window detector - the gain needed at frame pos - span, where span
+ * is the lookahead. Amortised O(1) per frame: each frame enters and leaves
+ * the monotonic deque once and the boxcar is a running sum. The result is a
+ * mean of window minima that all cover pos - span, so applying it to the
+ * delayed signal never lets a frame through above the threshold.
+ */
+static inline float windowTargetGain(_seymourAlgorithm* pThis, int side, uint32_t pos, uint32_t span, float requiredGain) {
+    _seymourWindow& w = pThis->limiter->window[side];
+    float* dequeGain = pThis->windowDequeGain[side];
+    uint32_t* dequePos = pThis->windowDequePos[side];
+    const _seymourRing& minGain = pThis->windowMinGain[side];
+    uint32_t mask = minGain.mask;
+
+    // Sliding minimum over frames pos - span .. pos
+    while (w.tail != w.head && dequeGain[(w.tail - 1) & mask] >= requiredGain) {
+        --w.tail;
+    }
+    dequeGain[w.tail & mask] = requiredGain;
+    dequePos[w.tail & mask] = pos;
+    ++w.tail;
+    while (pos - dequePos[w.head & mask] > span) {
+        ++w.head;
+    }
+    float windowMin = dequeGain[w.head & mask];
+
+    // Boxcar over the last span + 1 minima. The sum is rebuilt when the
+    // lookahead changes and once per trip around the ring to shed rounding.
+    uint32_t length = span + 1;
+    minGain.at(pos) = windowMin;
+    if (w.length != length || (pos & mask) == 0) {
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < length; ++i) {
+            sum += minGain.at(pos - i);
+        }
+        w.sum = sum;
+        w.length = length;
+        w.invLength = 1.0f / length;
+    } else {
+        w.sum += windowMin - minGain.at(pos - length);
+    }
+
+    float gain = w.sum * w.invLength;
+    return gain < windowMin ? gain : windowMin;
+}
+
+/**
+ * True when one side's window holds nothing but unity gain
+ */
+static inline bool windowAtRest(const _seymourAlgorithm* pThis, int side, uint32_t span) {
+    const _seymourWindow& w = pThis->limiter->window[side];
+    return w.active && w.length == span + 1 && w.sum == (float)w.length
+        && w.tail != w.head && pThis->windowDequeGain[side][w.head & pThis->windowMinGain[side].mask] == 1.0f;
+}
+
+/**
+ * Advance a resting window over numFrames frames that are all below threshold
+ */
+static inline void windowSkipIdle(_seymourAlgorithm* pThis, int side, uint32_t pos, uint32_t numFrames) {
+    _seymourWindow& w = pThis->limiter->window[side];
+    const _seymourRing& minGain = pThis->windowMinGain[side];
+    for (uint32_t i = 0; i < numFrames; ++i) {
+        minGain.at(pos + i) = 1.0f;
+    }
+    w.head = 0;
+    w.tail = 1;
+    pThis->windowDequeGain[side][0] = 1.0f;
+    pThis->windowDequePos[side][0] = pos + numFrames - 1;
+}
+
+/**
+ * Start the oversampler over from silence at the given factor
+ */
+static void setupOversampler(_seymourAlgorithm* pThis, int factor) {
     _seymourDTC* dtc = pThis->dtc;
+    for (int side = 0; side < 2; ++side) {
+        _seymourOversampler& os = pThis->oversampler[side];
+        memset(os.limited, 0, kOversampleBaseFrames * sizeof(float));
+        memset(os.threshold, 0, kOversampleBaseFrames * sizeof(float));
+        memset(os.residual2x, 0, kOversampleResidual2x * sizeof(float));
+        if (factor == 4) memset(os.residual4x, 0, kOversampleResidual4x * sizeof(float));
+    }
+    dtc->oversampleTail = 0;
+    dtc->oversampleFactor = factor;
+}
 
-    int numFrames = numFramesBy4 * 4;
-    int32_t numChannels = pThis->numChannels;
-    int globalBase = numChannels * kNumPerChannelParameters;
+/**
+ * Delay the oversampler gives the linear part of the signal, in frames
+ */
+static inline int oversampleLatency(int factor) {
+    return factor == 4 ? kOversampleLatency4x : kOversampleLatency2x;
+}
+
+/**
+ * Interpolate one side's limited chunk to the oversampled rate. Returns the
+ * n * factor oversampled samples, which the caller turns into the residual
+ * (saturated minus linear) in place before oversampleDown().
+ */
+static float* oversampleUp(_seymourAlgorithm* pThis, int side, int n) {
+    _seymourDTC* dtc = pThis->dtc;
+    _seymourOversampler& os = pThis->oversampler[side];
+    const float* limited = os.limited + kOversampleHistory;
+    if (dtc->oversampleFactor == 2) {
+        float* up2x = os.residual2x + 4 * kHalfbandTapsA;
+        halfbandUp<kHalfbandTapsA>(limited, up2x, n, halfbandA);
+        return up2x;
+    }
+    // The 2x stream is rebuilt from the base rate each chunk, together with
+    // the history the second stage reads, so it needs no state of its own
+    float* up2x = pThis->blockUp + 2 * kHalfbandTapsB;
+    halfbandUp<kHalfbandTapsA>(limited - kHalfbandTapsB, up2x - 2 * kHalfbandTapsB, n + kHalfbandTapsB, halfbandA);
+    float* up4x = os.residual4x + 4 * kHalfbandTapsB;
+    halfbandUp<kHalfbandTapsB>(up2x, up4x, 2 * n, halfbandB);
+    return up4x;
+}
+
+/**
+ * Decimate one side's residual back to the base rate and add the linear
+ * part, delayed to match
+ */
+static void oversampleDown(_seymourAlgorithm* pThis, int side, int n, float* out) {
+    _seymourDTC* dtc = pThis->dtc;
+    _seymourOversampler& os = pThis->oversampler[side];
+    float* residual2x = os.residual2x + 4 * kHalfbandTapsA;
+    if (dtc->oversampleFactor == 4) {
+        halfbandDown<kHalfbandTapsB>(os.residual4x + 4 * kHalfbandTapsB, residual2x, 2 * n, halfbandB);
+    }
+    halfbandDown<kHalfbandTapsA>(residual2x, out, n, halfbandA);
+    const float* linear = os.limited + kOversampleHistory - oversampleLatency(dtc->oversampleFactor);
+    for (int i = 0; i < n; ++i) {
+        out[i] += linear[i];
+    }
+}
+
+/**
+ * Move the chunk into the oversampler's history. The residual buffers only
+ * move while the decimators run; otherwise they hold zeros throughout.
+ */
+static void oversampleAdvance(_seymourAlgorithm* pThis, int n, bool residuals) {
+    _seymourDTC* dtc = pThis->dtc;
+    for (int side = 0; side < 2; ++side) {
+        _seymourOversampler& os = pThis->oversampler[side];
+        memmove(os.threshold, os.threshold + n, kOversampleHistory * sizeof(float));
+        memmove(os.limited, os.limited + n, kOversampleHistory * sizeof(float));
+        if (residuals) {
+            memmove(os.residual2x, os.residual2x + 2 * n, 4 * kHalfbandTapsA * sizeof(float));
+            if (dtc->oversampleFactor == 4) {
+                memmove(os.residual4x, os.residual4x + 4 * n, 4 * kHalfbandTapsB * sizeof(float));
+            }
+        }
+    }
+}
+
+/**
+ * Oversampled saturation of one chunk. The limiter pass leaves the limited
+ * signal and a per-frame saturation threshold (0 where it does not saturate)
+ * for each side in the oversampler; the result goes to the delayed-mix
+ * scratch.
+ *
+ * Only the residual of the curve, saturate(x) - x, goes through the halfband
+ * stages, and the linear part is just delayed by the same round trip. The
+ * residual is exactly zero wherever the limiter does not saturate, so once
+ * the decimators have drained a chunk with nothing saturating costs a copy.
+ */
+template <int kSatMode>
+static void oversampleSaturation(_seymourAlgorithm* pThis, int n) {
+    _seymourDTC* dtc = pThis->dtc;
+#if SEYMOUR_FAST_TANH == 2
+    const float* tanhTable = pThis->tanhTable;
+#else
+    const float* tanhTable = NULL;
+#endif
+    int factor = dtc->oversampleFactor;
+    float* outputs[2] = { dtc->blockDelayedL, dtc->blockDelayedR };
+
+    bool saturating = false;
+    for (int side = 0; side < 2; ++side) {
+        const float* threshold = pThis->oversampler[side].threshold + kOversampleHistory;
+        for (int i = 0; i < n; ++i) {
+            if (threshold[i] != 0.0f) saturating = true;
+        }
+    }
+    bool engaged = saturating || dtc->oversampleTail > 0;
+
+    // Oversampled samples i * factor onwards lie in frame i - align, counting
+    // the interpolators' delay
+    int align = factor == 4 ? kHalfbandTapsA + kHalfbandTapsB / 2 : kHalfbandTapsA;
+    for (int side = 0; side < 2; ++side) {
+        float* out = outputs[side];
+        if (!engaged) {
+            const float* linear = pThis->oversampler[side].limited + kOversampleHistory - oversampleLatency(factor);
+            memcpy(out, linear, n * sizeof(float));
+            continue;
+        }
+        const float* threshold = pThis->oversampler[side].threshold + kOversampleHistory;
+        float* signal = oversampleUp(pThis, side, n);
+        for (int i = 0; i < n; ++i) {
+            float t = threshold[i - align];
+            float* group = signal + i * factor;
+            if (t == 0.0f) {
+                for (int k = 0; k < factor; ++k) group[k] = 0.0f;
+                continue;
+            }
+            float invT = 1.0f / t;
+            for (int k = 0; k < factor; ++k) {
+                float x = group[k];
+                group[k] = saturate<kSatMode>(x * invT, tanhTable) * t - x;
+            }
+        }
+        oversampleDown(pThis, side, n, out);
+    }
+
+    oversampleAdvance(pThis, n, engaged);
+    if (saturating) {
+        dtc->oversampleTail = kOversampleTailFrames;
+    } else {
+        dtc->oversampleTail = dtc->oversampleTail > (uint32_t)n ? dtc->oversampleTail - n : 0;
+    }
+}
+
+/**
+ * Master level over one chunk of the mix scratch - nothing to do at a
+ * settled 100%
+ */
+static inline void applyLevel(_seymourDTC* dtc, int numFrames) {
+    float* mixL = dtc->blockMixL;
+    float* mixR = dtc->blockMixR;
+    const _seymourRamp& level = dtc->levelRamp;
+    if (level.step != 0.0f) {
+        for (int i = 0; i < numFrames; ++i) {
+            float gain = level.at(i);
+            mixL[i] *= gain;
+            mixR[i] *= gain;
+        }
+    } else if (level.to != 1.0f) {
+        for (int i = 0; i < numFrames; ++i) {
+            mixL[i] *= level.to;
+            mixR[i] *= level.to;
+        }
+    }
+}
+
+/**
+ * Set the limiter's detector sides up for a new link mode. Both sides carry
+ * on from side 0, and the windows start over, since what each side listens
+ * to has changed.
+ */
+static void linkLimiter(_seymourAlgorithm* pThis, int link) {
+    _seymourDTC* dtc = pThis->dtc;
+    dtc->envelope[1] = dtc->envelope[0];
+    dtc->gainReduction[1] = dtc->gainReduction[0];
+    pThis->limiter->window[0].active = false;
+    pThis->limiter->window[1].active = false;
+    dtc->limiterLink = link;
+}
+
+/**
+ * Detector input of each side over one chunk of the undelayed mix
+ */
+static inline void detectorInput(_seymourAlgorithm* pThis, int link, int numFrames) {
+    const float* mixL = pThis->dtc->blockMixL;
+    const float* mixR = pThis->dtc->blockMixR;
+    float* detectA = pThis->limiter->blockDetect[0];
+    float* detectB = pThis->limiter->blockDetect[1];
+    switch (link) {
+        case kLinkUnlinked:
+            for (int i = 0; i < numFrames; ++i) {
+                detectA[i] = fabsf(mixL[i]);
+                detectB[i] = fabsf(mixR[i]);
+            }
+            break;
+        case kLinkMidSide:
+            for (int i = 0; i < numFrames; ++i) {
+                detectA[i] = fabsf(mixL[i] + mixR[i]) * 0.5f;
+                detectB[i] = fabsf(mixL[i] - mixR[i]) * 0.5f;
+            }
+            break;
+        default:
+            for (int i = 0; i < numFrames; ++i) {
+                float absL = fabsf(mixL[i]);
+                float absR = fabsf(mixR[i]);
+                detectA[i] = absL > absR ? absL : absR;
+            }
+            break;
+    }
+}
+
+/**
+ * Peak envelope follower over m frames of detector input
+ */
+static inline float followEnvelope(const _seymourDTC* dtc, const float* detect, int m, float envelope) {
+    float attackCoeff = dtc->envelopeAttack;
+    float releaseCoeff = dtc->envelopeRelease;
+    for (int i = 0; i < m; ++i) {
+        float envCoeff = (detect[i] > envelope) ? attackCoeff : releaseCoeff;
+        envelope += envCoeff * (detect[i] - envelope);
+    }
+    return envelope;
+}
+
+/**
+ * Envelope detector for one side over one chunk. The envelope follows every
+ * frame, but the target gain and its smoother are only evaluated once per
+ * kDetectorFrames and the gain is interpolated linearly in between - the
+ * divide and the smoother run at a quarter of the rate, and a second side
+ * costs little more than its envelope. The target comes from the envelope
+ * over the threshold averaged across the frames, so a peak in the last of
+ * them reduces the gain no further than it would frame by frame.
+ */
+static void envelopeGains(_seymourAlgorithm* pThis, int side, int numFrames) {
+    _seymourDTC* dtc = pThis->dtc;
+    const float* detect = pThis->limiter->blockDetect[side];
+    float* gains = pThis->limiter->blockGain[side];
+    float* saturate = pThis->limiter->blockSaturate[side];
+    const _seymourRamp& threshold = dtc->thresholdRamp;
+    float envelope = dtc->envelope[side];
+    float gain = dtc->gainReduction[side];
+
+    for (int start = 0; start < numFrames; start += kDetectorFrames) {
+        int m = numFrames - start;
+        if (m > kDetectorFrames) m = kDetectorFrames;
+        float limit = threshold.at(start + m - 1);
+        float envelopes[kDetectorFrames];
+        float overSum = 0.0f;
+        bool over = false;
+        for (int i = 0; i < m; ++i) {
+            envelope = followEnvelope(dtc, detect + start + i, 1, envelope);
+            envelopes[i] = envelope;
+            over = over || envelope > limit;
+            overSum += envelope > limit ? envelope : limit;
+        }
+
+        float targetGain = over ? limit * m / overSum : 1.0f;
+        float from = gain;
+        gain += dtc->detectorGainCoeff[m] * (targetGain - gain);
+
+        // The ramp already leans towards a target set at the end of the
+        // frames, so only the envelope itself may start the saturation
+        float step = (gain - from) / m;
+        bool reducing = from < 0.9999f;
+        for (int i = 0; i < m; ++i) {
+            float g = from + step * (i + 1);
+            float t = threshold.at(start + i);
+            gains[start + i] = g;
+            saturate[start + i] = ((reducing && g < 0.9999f) || envelopes[i] > t) ? t : 0.0f;
+        }
+    }
+    dtc->envelope[side] = envelope;
+    dtc->gainReduction[side] = gain;
+}
+
+/**
+ * Sliding-window detector for one side over one chunk, frame by frame so
+ * it keeps its no-overshoot guarantee. Attack is shaped by the window and
+ * release by the gain smoother; the envelope is still followed for the Env
+ * output.
+ */
+static void windowGains(_seymourAlgorithm* pThis, int side, int numFrames, uint32_t pos, uint32_t span) {
+    _seymourDTC* dtc = pThis->dtc;
+    const float* detect = pThis->limiter->blockDetect[side];
+    float* gains = pThis->limiter->blockGain[side];
+    float* saturate = pThis->limiter->blockSaturate[side];
+    const _seymourRamp& threshold = dtc->thresholdRamp;
+    float gainSmoothCoeff = dtc->gainSmoothingCoeff;
+    float gain = dtc->gainReduction[side];
+
+    for (int i = 0; i < numFrames; ++i) {
+        float limit = threshold.at(i);
+        float requiredGain = (detect[i] > limit) ? limit / detect[i] : 1.0f;
+        float targetGain = windowTargetGain(pThis, side, pos + i, span, requiredGain);
+        if (targetGain < gain) {
+            gain = targetGain;
+        } else {
+            gain += gainSmoothCoeff * (targetGain - gain);
+        }
+        gains[i] = gain;
+        saturate[i] = gain < 0.9999f ? limit : 0.0f;
+    }
+    dtc->gainReduction[side] = gain;
+
+    dtc->envelope[side] = followEnvelope(dtc, detect, numFrames, dtc->envelope[side]);
+}
+
+/**
+ * Limiter pass - master level, lookahead delay, detectors and saturation
+ * over one chunk of the mix scratch, written to the output busses. Linked
+ * runs one detector side for both outputs; Unlinked and Mid-Side run two,
+ * and Mid-Side applies their gains to the mid and side signals.
+ */
+template <int kSatMode, int kDetector>
+static void processLimiter(_seymourAlgorithm* pThis, int numFrames,
+                           float* outL, bool replaceL, float* outR, bool replaceR) {
+    _seymourDTC* dtc = pThis->dtc;
+#if SEYMOUR_FAST_TANH == 2
+    const float* tanhTable = pThis->tanhTable;
+#else
+    const float* tanhTable = NULL;
+#endif
+
+    float* mixL = dtc->blockMixL;
+    float* mixR = dtc->blockMixR;
+    float* delayedBlockL = dtc->blockDelayedL;
+    float* delayedBlockR = dtc->blockDelayedR;
+    const _seymourRamp& threshold = dtc->thresholdRamp;
+
+    applyLevel(dtc, numFrames);
+
+    // Lookahead delay - write the chunk, then read it back delayed
+    uint32_t writeIdx = dtc->writeIndex;
+    uint32_t lookahead = dtc->lookaheadSamples;
+    uint32_t readIdx = writeIdx - lookahead;
+    pThis->lookaheadBuffer[0].write(writeIdx, mixL, numFrames);
+    pThis->lookaheadBuffer[1].write(writeIdx, mixR, numFrames);
+    dtc->writeIndex = writeIdx + numFrames;
+    dtc->lookaheadWritten = pThis->lookaheadBuffer[0].addWritten(dtc->lookaheadWritten, numFrames);
+    pThis->lookaheadBuffer[0].readWritten(readIdx, delayedBlockL, numFrames, dtc->writeIndex, dtc->lookaheadWritten);
+    pThis->lookaheadBuffer[1].readWritten(readIdx, delayedBlockR, numFrames, dtc->writeIndex, dtc->lookaheadWritten);
+
+    int link = pThis->globalControl.link;
+    if (dtc->limiterLink != link) linkLimiter(pThis, link);
+    int numSides = (link == kLinkLinked) ? 1 : 2;
+    detectorInput(pThis, link, numFrames);
+
+    _seymourLimiterDTC* limiter = pThis->limiter;
+    if (kDetector == kDetectorWindow) {
+        for (int side = 0; side < numSides; ++side) {
+            if (!limiter->window[side].active) primeWindow(pThis, side);
+        }
+    } else {
+        limiter->window[0].active = false;
+        limiter->window[1].active = false;
+    }
+
+    // With oversampling the limited signal and where it saturates go to the
+    // oversampler instead, which produces the output
+    int factor = pThis->globalControl.oversample;
+    if (dtc->oversampleFactor != factor) setupOversampler(pThis, factor);
+    bool oversampled = factor > 1;
+    float* oversampleL = pThis->oversampler[0].limited + kOversampleHistory;
+    float* oversampleR = pThis->oversampler[1].limited + kOversampleHistory;
+    float* oversampleThresholdL = pThis->oversampler[0].threshold + kOversampleHistory;
+    float* oversampleThresholdR = pThis->oversampler[1].threshold + kOversampleHistory;
+
+    // Idle fast path: every side is at rest and the whole chunk stays below
+    // threshold, so the gains stay at unity and the output is the delayed
+    // mix. The envelopes follow the chunk as usual; they cannot rise above
+    // the chunk peak, so they stay below threshold too.
+    bool atRest = true;
+    for (int side = 0; side < numSides; ++side) {
+        if (dtc->gainReduction[side] != 1.0f) atRest = false;
+        if (kDetector == kDetectorWindow && !windowAtRest(pThis, side, lookahead)) atRest = false;
+    }
+    if (atRest) {
+        float lowest = threshold.from < threshold.to ? threshold.from : threshold.to;
+        bool below = true;
+        for (int side = 0; side < numSides; ++side) {
+            const float* detect = limiter->blockDetect[side];
+            for (int i = 0; i < numFrames; ++i) {
+                if (detect[i] >= lowest) below = false;
+            }
+            if (dtc->envelope[side] >= lowest) below = false;
+        }
+        if (below) {
+            for (int side = 0; side < numSides; ++side) {
+                dtc->envelope[side] = followEnvelope(dtc, limiter->blockDetect[side], numFrames, dtc->envelope[side]);
+                if (kDetector == kDetectorWindow) {
+                    windowSkipIdle(pThis, side, writeIdx, numFrames);
+                }
+            }
+            if (oversampled) {
+                memcpy(oversampleL, delayedBlockL, numFrames * sizeof(float));
+                memcpy(oversampleR, delayedBlockR, numFrames * sizeof(float));
+                memset(oversampleThresholdL, 0, numFrames * sizeof(float));
+                memset(oversampleThresholdR, 0, numFrames * sizeof(float));
+                oversampleSaturation<kSatMode>(pThis, numFrames);
+            }
+            for (int i = 0; i < numFrames; ++i) {
+                if (replaceL) outL[i] = delayedBlockL[i];
+                else outL[i] += delayedBlockL[i];
+
+                if (replaceR) outR[i] = delayedBlockR[i];
+                else outR[i] += delayedBlockR[i];
+            }
+            return;
+        }
+    }
+
+    for (int side = 0; side < numSides; ++side) {
+        if (kDetector == kDetectorWindow) {
+            windowGains(pThis, side, numFrames, writeIdx, lookahead);
+        } else {
+            envelopeGains(pThis, side, numFrames);
+        }
+    }
+
+    // Apply the gains - to mid and side for Mid-Side - and saturate each
+    // output where its side saturates. Mid and side both reach both
+    // outputs, so with Mid-Side either one saturating saturates both.
+    const float* gainA = limiter->blockGain[0];
+    const float* gainB = limiter->blockGain[numSides - 1];
+    const float* saturateA = limiter->blockSaturate[0];
+    const float* saturateB = limiter->blockSaturate[numSides - 1];
+    bool midSide = (link == kLinkMidSide);
+    for (int i = 0; i < numFrames; ++i) {
+        float limitedL, limitedR, thresholdL, thresholdR;
+        if (midSide) {
+            float mid = (delayedBlockL[i] + delayedBlockR[i]) * 0.5f * gainA[i];
+            float side = (delayedBlockL[i] - delayedBlockR[i]) * 0.5f * gainB[i];
+            limitedL = mid + side;
+            limitedR = mid - side;
+            thresholdL = saturateA[i] != 0.0f ? saturateA[i] : saturateB[i];
+            thresholdR = thresholdL;
+        } else {
+            limitedL = delayedBlockL[i] * gainA[i];
+            limitedR = delayedBlockR[i] * gainB[i];
+            thresholdL = saturateA[i];
+            thresholdR = saturateB[i];
+        }
+
+        if (oversampled) {
+            oversampleL[i] = limitedL;
+            oversampleR[i] = limitedR;
+            oversampleThresholdL[i] = thresholdL;
+            oversampleThresholdR[i] = thresholdR;
+            continue;
+        }
+
+        float finalL = limitedL;
+        float finalR = limitedR;
+        if (thresholdL != 0.0f) finalL = saturate<kSatMode>(limitedL / thresholdL, tanhTable) * thresholdL;
+        if (thresholdR != 0.0f) finalR = saturate<kSatMode>(limitedR / thresholdR, tanhTable) * thresholdR;
+
+        if (replaceL) outL[i] = finalL;
+        else outL[i] += finalL;
+
+        if (replaceR) outR[i] = finalR;
+        else outR[i] += finalR;
+    }
+
+    if (oversampled) {
+        oversampleSaturation<kSatMode>(pThis, numFrames);
+        for (int i = 0; i < numFrames; ++i) {
+            if (replaceL) outL[i] = delayedBlockL[i];
+            else outL[i] += delayedBlockL[i];
 
-    // Get output busses
-    int outLBus = pThis->v[globalBase + kParamOutputL] - 1;
-    int outRBus = pThis->v[globalBase + kParamOutputR] - 1;
-    bool replaceL = pThis->v[globalBase + kParamOutputLMode];
-    bool replaceR = pThis->v[globalBase + kParamOutputRMode];
+            if (replaceR) outR[i] = delayedBlockR[i];
+            else outR[i] += delayedBlockR[i];
+        }
+    }
+
+    // Settle onto unity gain once nothing is over threshold, so the idle
+    // path can take over
+    for (int side = 0; side < numSides; ++side) {
+        if (dtc->gainReduction[side] > kGainRestThreshold && dtc->envelope[side] < threshold.to) {
+            dtc->gainReduction[side] = 1.0f;
+        }
+    }
+}
+
+/**
+ * Run the limiter kernel for the current saturation mode and detector
+ */
+template <int kSatMode>
+static void runLimiter(_seymourAlgorithm* pThis, int numFrames, float* outL, float* outR) {
+    const _seymourGlobalControl& gc = pThis->globalControl;
+    if (gc.detector == kDetectorWindow) {
+        processLimiter<kSatMode, kDetectorWindow>(pThis, numFrames, outL, gc.replaceL, outR, gc.replaceR);
+    } else {
+        processLimiter<kSatMode, kDetectorEnvelope>(pThis, numFrames, outL, gc.replaceL, outR, gc.replaceR);
+    }
+}
+
+/**
+ * Lite output pass - master level and a feed-forward peak clipper: frames
+ * above kClipperKnee of the Squash threshold go through the saturation curve
+ * (see clip()) and the rest pass untouched, with no lookahead, detector or
+ * gain state, so no latency
+ */
+template <int kSatMode>
+static void processClipper(_seymourAlgorithm* pThis, int numFrames,
+                           float* outL, bool replaceL, float* outR, bool replaceR) {
+    _seymourDTC* dtc = pThis->dtc;
+#if SEYMOUR_FAST_TANH == 2
+    const float* tanhTable = pThis->tanhTable;
+#else
+    const float* tanhTable = NULL;
+#endif
+    const float* mixL = dtc->blockMixL;
+    const float* mixR = dtc->blockMixR;
+    const _seymourRamp& threshold = dtc->thresholdRamp;
 
-    float* outL = busFrames + outLBus * numFrames;
-    float* outR = busFrames + outRBus * numFrames;
+    applyLevel(dtc, numFrames);
 
-    // Get global parameters
-    float masterTarget = pThis->v[globalBase + kParamMasterLevel] / 100.0f;
-    float cascadeTarget = pThis->v[globalBase + kParamCascade] / 100.0f;  // 0-1.5 (150%)
-    int satMode = pThis->v[globalBase + kParamSaturation];
-    float squashTarget = pThis->v[globalBase + kParamSquash] / 100.0f;
-    if (squashTarget < 0.0f) squashTarget = 0.0f;
-    if (squashTarget > 1.0f) squashTarget = 1.0f;
+    for (int i = 0; i < numFrames; ++i) {
+        float limiterThresholdVolts = threshold.at(i);
+        float invThreshold = 1.0f / limiterThresholdVolts;
+        float finalL = clip<kSatMode>(mixL[i] * invThreshold, tanhTable) * limiterThresholdVolts;
+        float finalR = clip<kSatMode>(mixR[i] * invThreshold, tanhTable) * limiterThresholdVolts;
+
+        if (replaceL) outL[i] = finalL;
+        else outL[i] += finalL;
+
+        if (replaceR) outR[i] = finalR;
+        else outR[i] += finalR;
+    }
+}
+
+/**
+ * Feedback pass for one channel: DC block each tap and add it to the input
+ * at the cascade gain. Returns the chunk peak of the result.
+ */
+template <bool kRamp>
+static inline float feedbackPass(float* channelBlock, const float* tapBlock, int numFrames,
+                                 float& x1, float& y1, float dcCoeff, const _seymourRamp& cascade) {
+    float peak = 0.0f;
+    for (int i = 0; i < numFrames; ++i) {
+        float feedbackTap = tapBlock[i];
+
+        // DC blocker on feedback to prevent runaway
+        float feedbackFiltered = dcBlock(feedbackTap, x1, y1, dcCoeff);
+
+        // Add cascade feedback from previous channel
+        float processed = channelBlock[i] + feedbackFiltered * (kRamp ? cascade.at(i) : cascade.to);
+        channelBlock[i] = processed;
+
+        float level = fabsf(processed);
+        if (level > peak) peak = level;
+    }
+    return peak;
+}
+
+/**
+ * Longest tap delay a lane can be given (frames)
+ */
+static inline float maxTapDelay(const _seymourAlgorithm* pThis) {
+    return (float)(maxDelayFrames(pThis->feedbackDelayBuffer[0]) - 1);
+}
+
+/**
+ * A lane's tap delay from the global FB Delay and its Delay parameter (frames)
+ */
+static inline float baseTapDelay(const _seymourAlgorithm* pThis, int ch) {
+    float delay = pThis->dtc->feedbackDelaySamples * pThis->channelControl[ch].delayScale;
+    if (delay < kMinTapDelayFrames) delay = kMinTapDelayFrames;
+    if (delay > maxTapDelay(pThis)) delay = maxTapDelay(pThis);
+    return delay;
+}
+
+/**
+ * Longest chunk the lanes' tap delays allow, so every tap read in a chunk
+ * was written by an earlier chunk. A whole-frame delay d allows d frames; an
+ * interpolated tap also reads the frame after it, so allows one less than
+ * its delay rounded up. CV-modulated delays are kept above the chunk length
+ * as they move (see updateTapDelays()).
+ */
+static int tapChunkLimit(const _seymourAlgorithm* pThis, int n) {
+    for (int ch = 0; ch < pThis->numChannels; ++ch) {
+        bool modulated = pThis->channelControl[ch].delayCVConnected;
+        float delay = modulated ? pThis->delaySmoothed[ch] : baseTapDelay(pThis, ch);
+        int limit = (!modulated && delay == floorf(delay)) ? (int)delay : (int)ceilf(delay) - 1;
+        if (n > limit) n = limit;
+    }
+    return n;
+}
+
+/**
+ * Each lane's tap delay across a chunk of n frames. Without Delay CV a lane
+ * follows its Delay parameter at once, as the global FB Delay always has;
+ * with CV the delay is smoothed at control rate, like the pan, rate limited
+ * so the read position never runs backwards, and ramped across the chunk.
+ */
+static void updateTapDelays(_seymourAlgorithm* pThis, const float* busFrames, int numFrames, int offset, int n) {
+    _seymourDTC* dtc = pThis->dtc;
+    float maxDelay = maxTapDelay(pThis);
+
+    for (int ch = 0; ch < pThis->numChannels; ++ch) {
+        const _seymourChannelControl& cc = pThis->channelControl[ch];
+        float from = baseTapDelay(pThis, ch);
+        float to = from;
+
+        if (cc.delayCVConnected) {
+            const float* cv = busFrames + cc.delayCVBus * numFrames + offset;
+            float cvSum = 0.0f;
+            for (int i = 0; i < n; ++i) {
+                cvSum += cv[i];
+            }
+            float target = from * (1.0f + cvSum / (n * 5.0f) * cc.delayCVDepth);
+
+            from = pThis->delaySmoothed[ch];
+            to = from + dtc->controlSmoothingCoeff[n] * (target - from);
+            float slew = kMaxTapDelaySlew * n;
+            if (to > from + slew) to = from + slew;
+            if (to < from - slew) to = from - slew;
+            if (to < n + 1.0f) to = n + 1.0f;
+            if (to < kMinTapDelayFrames) to = kMinTapDelayFrames;
+            if (to > maxDelay) to = maxDelay;
+        }
+        pThis->delaySmoothed[ch] = to;
+
+        _seymourRamp& delay = pThis->tapDelay[ch];
+        delay.from = from;
+        delay.to = to;
+        delay.step = (to - from) / n;
+        bool whole = (delay.step == 0.0f && to == floorf(to));
+        pThis->tapReach[ch] = whole ? (uint32_t)to : (uint32_t)ceilf(from > to ? from : to) + 1;
+    }
+}
+
+/**
+ * Read one chunk of a lane's feedback taps at its tap delay (see
+ * updateTapDelays()). A constant whole-frame delay is a block copy; anything
+ * else is linearly interpolated, with the read position advanced by
+ * 1 - (delay step) per frame, so a tap costs one multiply-add more.
+ */
+static void readTaps(const _seymourAlgorithm* pThis, int lane, float* dst, int n, uint32_t writeStart) {
+    const _seymourDTC* dtc = pThis->dtc;
+    const _seymourRing& ring = pThis->feedbackDelayBuffer[lane];
+    const _seymourRamp& delay = pThis->tapDelay[lane];
+    uint32_t written = dtc->feedbackWritten;
+
+    if (delay.step == 0.0f && delay.to == floorf(delay.to)) {
+        ring.readWritten(writeStart - (uint32_t)delay.to, dst, n, writeStart, written);
+        return;
+    }
+
+    // Read position for frame i is writeStart + i - delay.at(i), kept as a
+    // whole frame index and a fraction in 0..1
+    float first = delay.from + delay.step;
+    uint32_t whole = (uint32_t)first;
+    uint32_t index = writeStart - whole - 1;
+    float frac = 1.0f - (first - whole);
+    float advance = 1.0f - delay.step;
+    bool gated = written < ring.frames();
+
+    for (int i = 0; i < n; ++i) {
+        if (frac >= 1.0f) {
+            uint32_t carry = (uint32_t)frac;
+            index += carry;
+            frac -= carry;
+        }
+        float a = ring.at(index);
+        float b = ring.at(index + 1);
+        if (gated) {
+            if (writeStart - index > written) a = 0.0f;
+            if (writeStart - index - 1 > written) b = 0.0f;
+        }
+        dst[i] = a + frac * (b - a);
+        frac += advance;
+    }
+}
+
+/**
+ * Feedback taps for the matrix topologies: reads every lane's taps for the
+ * chunk into blockLanes and mixes them across channels in place, a row of
+ * frames at a time. Hadamard is the fast Walsh-Hadamard transform (log2 N
+ * butterfly stages) normalised to unit gain; a channel count that is not a
+ * power of two is zero-padded and the extra outputs dropped, which keeps the
+ * mix contractive. Householder is the reflection I - (2/N) 11ᵀ, one sum and
+ * one subtraction per channel.
+ */
+template <int kNumChannels>
+static void mixTaps(_seymourAlgorithm* pThis, int topology, uint32_t fbWriteStart, int n) {
+    enum { kSize = kNumChannels <= 1 ? 1 : kNumChannels <= 2 ? 2 : kNumChannels <= 4 ? 4 : 8 };
+    float (*lane)[kBlockFrames] = pThis->blockLanes;
+
+    for (int ch = 0; ch < kNumChannels; ++ch) {
+        readTaps(pThis, ch, lane[ch], n, fbWriteStart);
+    }
+
+    if (topology == kTopologyHadamard) {
+        for (int ch = kNumChannels; ch < kSize; ++ch) {
+            memset(lane[ch], 0, n * sizeof(float));
+        }
+        for (int h = 1; h < kSize; h <<= 1) {
+            for (int a = 0; a < kSize; a += 2 * h) {
+                for (int b = a; b < a + h; ++b) {
+                    float* x = lane[b];
+                    float* y = lane[b + h];
+                    for (int i = 0; i < n; ++i) {
+                        float sum = x[i] + y[i];
+                        y[i] = x[i] - y[i];
+                        x[i] = sum;
+                    }
+                }
+            }
+        }
+        const float scale = 1.0f / sqrtf((float)kSize);
+        for (int ch = 0; ch < kNumChannels; ++ch) {
+            for (int i = 0; i < n; ++i) {
+                lane[ch][i] *= scale;
+            }
+        }
+    } else {
+        const float scale = 2.0f / kNumChannels;
+        for (int i = 0; i < n; ++i) {
+            float sum = 0.0f;
+            for (int ch = 0; ch < kNumChannels; ++ch) {
+                sum += lane[ch][i];
+            }
+            sum *= scale;
+            for (int ch = 0; ch < kNumChannels; ++ch) {
+                lane[ch][i] -= sum;
+            }
+        }
+    }
+}
+
+#if SEYMOUR_SIMD
+// Input for channels without an input bus and for the padding lanes
+static const float zeroBlock[kBlockFrames] = {};
+
+/**
+ * Channel-parallel feedback and pan/mix pass (SEYMOUR_SIMD): gathers four
+ * channels into the lanes of a vector (taken from blockLanes when tapsMixed,
+ * see mixTaps()) and runs the input, DC blocker,
+ * cascade gain and pan ramp for all of them a frame at a time, then sums
+ * the lanes into the mix. Every lane does exactly what feedbackPass() and
+ * panAndMix() do for its channel; only the order the channels are added
+ * into the mix differs. A group of four whose channels are all idle, by the
+ * same test as the scalar pass in stepKernel(), is left out of the chunk.
+ */
+template <int kNumChannels>
+static void feedbackChannelsSimd(_seymourAlgorithm* pThis, const float* busFrames, int numFrames, int offset, int n,
+                                 const _seymourRamp& cascade, uint32_t fbWriteStart, bool tapsMixed) {
+    enum { kGroups = (kNumChannels + 3) / 4, kLanes = kGroups * 4 };
+    _seymourDTC* dtc = pThis->dtc;
+    const _seymourRing* feedbackRing = pThis->feedbackDelayBuffer;
+    float* mixL = dtc->blockMixL;
+    float* mixR = dtc->blockMixR;
+    float (*lane)[kBlockFrames] = pThis->blockLanes;
+
+    // Silence at the end of each lane before this chunk is written
+    bool lanesSilent = true;
+    for (int ch = 0; ch < kNumChannels; ++ch) {
+        if (pThis->silentFrames[ch] < pThis->tapReach[ch]) lanesSilent = false;
+    }
+
+    // Idle channels: no input, a settled pan, and every tap they read this
+    // chunk and their DC blocker silent. Padding lanes are always idle, and
+    // only groups with a channel that is not idle are run.
+    bool skipped[kLanes];
+    int activeGroups[kGroups];
+    int numActive = 0;
+    for (int g = 0; g < kGroups; ++g) {
+        bool groupIdle = true;
+        for (int ch = g * 4; ch < g * 4 + 4 && ch < kNumChannels; ++ch) {
+            const _seymourChannelControl& cc = pThis->channelControl[ch];
+            const int feedbackSourceCh = (ch == 0) ? kNumChannels - 1 : ch - 1;
+            bool tapsSilent = tapsMixed ? lanesSilent
+                                        : pThis->silentFrames[feedbackSourceCh] >= pThis->tapReach[feedbackSourceCh];
+            if (cc.inputBus >= 0 || cc.panCVConnected || pThis->panSmoothed[ch] != cc.pan || !tapsSilent
+                || fabsf(pThis->dcBlockerX1[ch]) >= kSilenceThresholdVolts
+                || fabsf(pThis->dcBlockerY1[ch]) >= kSilenceThresholdVolts) {
+                groupIdle = false;
+            }
+        }
+        for (int ch = g * 4; ch < g * 4 + 4; ++ch) {
+            skipped[ch] = groupIdle;
+        }
+        if (!groupIdle) activeGroups[numActive++] = g;
+    }
+
+    // Per-lane state; padding lanes have no input, taps or gain
+    const float* input[kLanes];
+    const float* panCV[kLanes];
+    bool panMoving[kLanes];
+    float panSmoothed[kLanes];
+    float gainL[kLanes], gainR[kLanes];
+    float x1[kLanes], y1[kLanes];
+    for (int ch = 0; ch < kLanes; ++ch) {
+        if (ch < kNumChannels) {
+            const _seymourChannelControl& cc = pThis->channelControl[ch];
+            const int feedbackSourceCh = (ch == 0) ? kNumChannels - 1 : ch - 1;
+            input[ch] = cc.inputBus >= 0 ? busFrames + cc.inputBus * numFrames + offset : zeroBlock;
+            panCV[ch] = cc.panCVConnected ? busFrames + cc.panCVBus * numFrames + offset : NULL;
+            panMoving[ch] = panCV[ch] || pThis->panSmoothed[ch] != cc.pan;
+            panSmoothed[ch] = pThis->panSmoothed[ch];
+            gainL[ch] = pThis->panGainL[ch];
+            gainR[ch] = pThis->panGainR[ch];
+            x1[ch] = pThis->dcBlockerX1[ch];
+            y1[ch] = pThis->dcBlockerY1[ch];
+            if (!tapsMixed && !skipped[ch]) readTaps(pThis, feedbackSourceCh, lane[ch], n, fbWriteStart);
+        } else {
+            input[ch] = zeroBlock;
+            panCV[ch] = NULL;
+            panMoving[ch] = false;
+            gainL[ch] = gainR[ch] = x1[ch] = y1[ch] = 0.0f;
+            if (!skipped[ch]) memset(lane[ch], 0, n * sizeof(float));
+        }
+    }
+
+    _seymourVec dcCoeff = vecSplat(dtc->dcBlockerCoeff);
+    _seymourVec x1v[kGroups], y1v[kGroups], peak[kGroups];
+    for (int g = 0; g < kGroups; ++g) {
+        x1v[g] = vecLoad(x1 + g * 4);
+        y1v[g] = vecLoad(y1 + g * 4);
+        peak[g] = vecSplat(0.0f);
+    }
+
+    // With every group idle the chunk adds nothing to the mix
+    for (int start = 0; numActive > 0 && start < n; start += kControlFrames) {
+        int m = n - start;
+        if (m > kControlFrames) m = kControlFrames;
+
+        // Pan gains at the end of this control interval, ramped linearly
+        float nextL[kLanes], nextR[kLanes], stepL[kLanes], stepR[kLanes];
+        for (int ch = 0; ch < kLanes; ++ch) {
+            nextL[ch] = gainL[ch];
+            nextR[ch] = gainR[ch];
+            if (panMoving[ch]) {
+                panControlPoint(pThis, ch, panCV[ch] ? panCV[ch] + start : NULL, m, panSmoothed[ch], nextL[ch], nextR[ch]);
+            }
+            stepL[ch] = (nextL[ch] - gainL[ch]) / m;
+            stepR[ch] = (nextR[ch] - gainR[ch]) / m;
+        }
+        _seymourVec gL[kGroups], gR[kGroups], sL[kGroups], sR[kGroups];
+        for (int g = 0; g < kGroups; ++g) {
+            gL[g] = vecLoad(gainL + g * 4);
+            gR[g] = vecLoad(gainR + g * 4);
+            sL[g] = vecLoad(stepL + g * 4);
+            sR[g] = vecLoad(stepR + g * 4);
+        }
+
+        for (int i = start; i < start + m; ++i) {
+            _seymourVec gain = vecSplat(cascade.step != 0.0f ? cascade.at(i) : cascade.to);
+            _seymourVec sumL = vecSplat(0.0f);
+            _seymourVec sumR = vecSplat(0.0f);
+            for (int a = 0; a < numActive; ++a) {
+                const int g = activeGroups[a];
+                const int c = g * 4;
+                _seymourVec in = vecSet(input[c][i], input[c + 1][i], input[c + 2][i], input[c + 3][i]);
+                _seymourVec tap = vecSet(lane[c][i], lane[c + 1][i], lane[c + 2][i], lane[c + 3][i]);
+
+                // DC blocker on the taps, then the cascade gain
+                _seymourVec filtered = vecAdd(vecSub(tap, x1v[g]), vecMul(dcCoeff, y1v[g]));
+                x1v[g] = tap;
+                y1v[g] = filtered;
+                _seymourVec processed = vecAdd(in, vecMul(filtered, gain));
+                peak[g] = vecMax(peak[g], vecAbs(processed));
+
+                float out[4];
+                vecStore(out, processed);
+                lane[c][i] = out[0];
+                lane[c + 1][i] = out[1];
+                lane[c + 2][i] = out[2];
+                lane[c + 3][i] = out[3];
+
+                gL[g] = vecAdd(gL[g], sL[g]);
+                gR[g] = vecAdd(gR[g], sR[g]);
+                sumL = vecAdd(sumL, vecMul(processed, gL[g]));
+                sumR = vecAdd(sumR, vecMul(processed, gR[g]));
+            }
+            mixL[i] += vecSum(sumL);
+            mixR[i] += vecSum(sumR);
+        }
+
+        for (int ch = 0; ch < kLanes; ++ch) {
+            gainL[ch] = nextL[ch];
+            gainR[ch] = nextR[ch];
+        }
+    }
+
+    // Lane results into the feedback lanes, and the state back per channel
+    float peaks[kLanes];
+    for (int g = 0; g < kGroups; ++g) {
+        vecStore(x1 + g * 4, x1v[g]);
+        vecStore(y1 + g * 4, y1v[g]);
+        vecStore(peaks + g * 4, peak[g]);
+    }
+    for (int ch = 0; ch < kNumChannels; ++ch) {
+        if (skipped[ch]) {
+            // Its lane only needs zeros until the whole ring is silent
+            pThis->dcBlockerX1[ch] = 0.0f;
+            pThis->dcBlockerY1[ch] = 0.0f;
+            if (pThis->silentFrames[ch] < feedbackRing[ch].frames()) {
+                feedbackRing[ch].write(fbWriteStart, zeroBlock, n);
+                pThis->silentFrames[ch] += n;
+            }
+            continue;
+        }
+        feedbackRing[ch].write(fbWriteStart, lane[ch], n);
+        if (peaks[ch] < kSilenceThresholdVolts) {
+            if (pThis->silentFrames[ch] < feedbackRing[ch].frames()) pThis->silentFrames[ch] += n;
+        } else {
+            pThis->silentFrames[ch] = 0;
+        }
+        pThis->dcBlockerX1[ch] = x1[ch];
+        pThis->dcBlockerY1[ch] = y1[ch];
+        pThis->panSmoothed[ch] = panSmoothed[ch];
+        pThis->panGainL[ch] = gainL[ch];
+        pThis->panGainR[ch] = gainR[ch];
+    }
+}
+#endif
+
+/**
+ * Run the limiter for the current saturation mode
+ */
+static void runSaturation(_seymourAlgorithm* pThis, int numFrames, float* outL, float* outR) {
+    switch (pThis->globalControl.saturationMode) {
+        case kSaturationTube:
+            runLimiter<kSaturationTube>(pThis, numFrames, outL, outR);
+            break;
+        case kSaturationHard:
+            runLimiter<kSaturationHard>(pThis, numFrames, outL, outR);
+            break;
+        default:
+            runLimiter<kSaturationSoft>(pThis, numFrames, outL, outR);
+            break;
+    }
+}
+
+/**
+ * Run the Lite clipper for the current saturation mode
+ */
+static void runClipper(_seymourAlgorithm* pThis, int numFrames, float* outL, float* outR) {
+    const _seymourGlobalControl& gc = pThis->globalControl;
+    switch (gc.saturationMode) {
+        case kSaturationTube:
+            processClipper<kSaturationTube>(pThis, numFrames, outL, gc.replaceL, outR, gc.replaceR);
+            break;
+        case kSaturationHard:
+            processClipper<kSaturationHard>(pThis, numFrames, outL, gc.replaceL, outR, gc.replaceR);
+            break;
+        default:
+            processClipper<kSaturationSoft>(pThis, numFrames, outL, gc.replaceL, outR, gc.replaceR);
+            break;
+    }
+}
+
+/**
+ * Write one CV output over a chunk: a linear ramp from the value written at
+ * the end of the previous chunk to this one's
+ */
+static inline void rampCVOutput(float* out, float& last, float value, int n) {
+    float step = (value - last) / n;
+    for (int i = 0; i < n; ++i) {
+        out[i] = last + step * (i + 1);
+    }
+    last = value;
+}
+
+/**
+ * The limiter's lowest gain and highest envelope across the detector sides
+ * in use
+ */
+static inline void limiterLevels(const _seymourDTC* dtc, float& gain, float& envelope) {
+    gain = dtc->gainReduction[0];
+    envelope = dtc->envelope[0];
+    if (dtc->limiterLink != kLinkLinked) {
+        if (dtc->gainReduction[1] < gain) gain = dtc->gainReduction[1];
+        if (dtc->envelope[1] > envelope) envelope = dtc->envelope[1];
+    }
+}
+
+/**
+ * Gain reduction and envelope CV outputs for one chunk. The limiter state is
+ * sampled once at the end of the chunk and interpolated across it, so the
+ * outputs cost a ramp per chunk rather than any per-frame work. With two
+ * detector sides they follow the one limiting hardest.
+ */
+static void writeLimiterCVs(_seymourAlgorithm* pThis, float* busFrames, int numFrames, int offset, int n) {
+    const _seymourGlobalControl& gc = pThis->globalControl;
+    _seymourDTC* dtc = pThis->dtc;
+    float gainReduction, envelope;
+    limiterLevels(dtc, gainReduction, envelope);
+    if (gc.grOutBus >= 0) {
+        float volts = 0.0f;
+        if (gainReduction < 1.0f) {
+            float gain = gainReduction > 1.0e-6f ? gainReduction : 1.0e-6f;
+            volts = -20.0f * log10f(gain) * kGainReductionVoltsPerDb;
+            if (volts > kCVOutputMaxVolts) volts = kCVOutputMaxVolts;
+        }
+        rampCVOutput(busFrames + gc.grOutBus * numFrames + offset, dtc->grOutput, volts, n);
+    }
+    if (gc.envOutBus >= 0) {
+        float volts = envelope < kCVOutputMaxVolts ? envelope : kCVOutputMaxVolts;
+        rampCVOutput(busFrames + gc.envOutBus * numFrames + offset, dtc->envOutput, volts, n);
+    }
+}
+
+/**
+ * Clear the feedback lanes and DC blockers, so the cascade restarts from
+ * silence rather than from history left over before the pure-mixer path.
+ * The lanes are cleared lazily: the taps read zero until they are written
+ * again, and idle channels keep writing their lanes until every frame has
+ * been rewritten.
+ */
+static void flushFeedback(_seymourAlgorithm* pThis) {
+    for (int ch = 0; ch < pThis->numChannels; ++ch) {
+        pThis->silentFrames[ch] = 0;
+        pThis->dcBlockerX1[ch] = 0.0f;
+        pThis->dcBlockerY1[ch] = 0.0f;
+    }
+    pThis->dtc->feedbackWritten = 0;
+    pThis->feedbackStale = false;
+}
+
+/**
+ * Return the limiter to rest with an empty lookahead and oversampler (Full
+ * mode only)
+ */
+static void resetLimiter(_seymourAlgorithm* pThis) {
+    _seymourDTC* dtc = pThis->dtc;
+    dtc->lookaheadWritten = 0;
+    for (int side = 0; side < 2; ++side) {
+        dtc->envelope[side] = 0.0f;
+        dtc->gainReduction[side] = 1.0f;
+        pThis->limiter->window[side].active = false;
+    }
+    dtc->oversampleFactor = 1;
+}
+
+/**
+ * Pure-mixer pass for Cascade at 0%: with no feedback each channel is just
+ * panned into the mix, straight from its input bus
+ */
+template <int kNumChannels>
+static void mixChannels(_seymourAlgorithm* pThis, float* busFrames, int numFrames, int offset, int n) {
+    float* channelBlock = pThis->dtc->blockChannel;
+
+    for (int ch = 0; ch < kNumChannels; ++ch) {
+        const _seymourChannelControl& cc = pThis->channelControl[ch];
+
+        const float* input;
+        if (cc.inputBus >= 0) {
+            input = busFrames + cc.inputBus * numFrames + offset;
+        } else if (!cc.panCVConnected && pThis->panSmoothed[ch] == cc.pan) {
+            continue;
+        } else {
+            // Silent, but the pan smoother still has to move
+            memset(channelBlock, 0, n * sizeof(float));
+            input = channelBlock;
+        }
+
+        const float* panCV = cc.panCVConnected ? busFrames + cc.panCVBus * numFrames + offset : NULL;
+        panAndMix(pThis, ch, input, panCV, n);
+    }
+}
+
+#if SEYMOUR_INSTRUMENT
+/**
+ * Add one step() call to the cycle statistics, publishing the window for
+ * draw() every quarter of a second of audio
+ */
+static void recordCycles(_seymourAlgorithm* pThis, const _seymourProfile& profile, int numFrames) {
+    _seymourCycleStats& c = pThis->cycles;
+    uint32_t total = cycleCount() - profile.start;
+
+    if (total < c.minStep) c.minStep = total;
+    if (total > c.maxStep) c.maxStep = total;
+    c.sumStep += total;
+    for (int s = 0; s < kNumStages; ++s) {
+        c.sumStage[s] += profile.stage[s];
+    }
+    ++c.steps;
+    c.frames += numFrames;
+
+    if (c.frames >= NT_globals.sampleRate / 4) {
+        c.shownMin = c.minStep;
+        c.shownMax = c.maxStep;
+        c.shownAvg = (uint32_t)(c.sumStep / c.steps);
+        for (int s = 0; s < kNumStages; ++s) {
+            c.shownStage[s] = (uint32_t)(c.sumStage[s] / c.steps);
+            c.sumStage[s] = 0;
+        }
+        c.shownPerFrame = (uint32_t)(c.sumStep / c.frames);
+        c.steps = 0;
+        c.frames = 0;
+        c.minStep = 0xFFFFFFFFu;
+        c.maxStep = 0;
+        c.sumStep = 0;
+    }
+}
+#endif
+
+/**
+ * Step kernel, instantiated once per channel count so the channel loop and
+ * the ring neighbour lookups are resolved at compile time
+ */
+template <int kNumChannels, bool kLite>
+static void stepKernel(_seymourAlgorithm* pThis, float* busFrames, int numFramesBy4) {
+    _seymourDTC* dtc = pThis->dtc;
+    const _seymourGlobalControl& gc = pThis->globalControl;
+
+    int numFrames = numFramesBy4 * 4;
+
+    float cascadeTarget = gc.cascade;
+    float squashTarget = gc.squash;
 
     // Coefficients
+    const float* blockCoeff = dtc->controlSmoothingCoeff;
+
+    float* mixL = dtc->blockMixL;
+    float* mixR = dtc->blockMixR;
+
+    _seymourProfile profile;
+
+    // Process the host block in chunks. A chunk is never longer than the
+    // feedback delay, so every feedback tap read within a chunk was written
+    // by an earlier chunk and the channels can be processed one at a time.
+    //
+    // Every bus read for a chunk (inputs, Pan CV and Delay CV) happens in the
+    // mix and feedback stages, before the limiter and the CV outputs write
+    // that chunk's frames, and later chunks only read later frames. So any
+    // output may share a bus with any input - processing in place needs no
+    // aliasing check and no copies.
+    for (int offset = 0; offset < numFrames; ) {
+        int n = numFrames - offset;
+        if (n > kBlockFrames) n = kBlockFrames;
+        n = tapChunkLimit(pThis, n);
+
+        bool pureMixer = (cascadeTarget == 0.0f && dtc->cascadeSmoothed.value == 0.0f);
+
+        // Smooth global parameters into this chunk's ramps
+        _seymourRamp cascade = dtc->cascadeSmoothed.advance(cascadeTarget, blockCoeff, n);
+        dtc->levelRamp = dtc->masterLevelSmoothed.advance(gc.masterLevel, blockCoeff, n);
+        _seymourRamp squash = dtc->squashSmoothed.advance(squashTarget, blockCoeff, n);
+        const float thresholdRange = kLimiterThresholdMaxVolts - kLimiterThresholdMinVolts;
+        dtc->thresholdRamp.from = kLimiterThresholdMaxVolts - thresholdRange * squash.from;
+        dtc->thresholdRamp.to = kLimiterThresholdMaxVolts - thresholdRange * squash.to;
+        dtc->thresholdRamp.step = -thresholdRange * squash.step;
+
+        memset(mixL, 0, n * sizeof(float));
+        memset(mixR, 0, n * sizeof(float));
+
+        float* outL = busFrames + gc.outLBus * numFrames + offset;
+        float* outR = busFrames + gc.outRBus * numFrames + offset;
+
+        if (pureMixer) {
+            mixChannels<kNumChannels>(pThis, busFrames, numFrames, offset, n);
+            pThis->feedbackStale = true;
+            profile.split(kStageMix);
+            if (kLite) {
+                runClipper(pThis, n, outL, outR);
+            } else {
+                runSaturation(pThis, n, outL, outR);
+                writeLimiterCVs(pThis, busFrames, numFrames, offset, n);
+            }
+            profile.split(kStageLimiter);
+            offset += n;
+            continue;
+        }
+        profile.split(kStageMix);
+        if (pThis->feedbackStale) flushFeedback(pThis);
+
+        // Feedback lanes share one write position; each is read at its own delay
+        uint32_t fbWriteStart = dtc->feedbackWriteIndex;
+        updateTapDelays(pThis, busFrames, numFrames, offset, n);
+
+        // The matrix topologies take every channel's taps from every lane,
+        // so they are mixed up front; the ring reads each channel's taps as
+        // it goes
+        bool tapsMixed = (gc.topology != kTopologyRing);
+        if (tapsMixed) mixTaps<kNumChannels>(pThis, gc.topology, fbWriteStart, n);
+
+#if SEYMOUR_SIMD
+        feedbackChannelsSimd<kNumChannels>(pThis, busFrames, numFrames, offset, n, cascade, fbWriteStart, tapsMixed);
+        profile.split(kStageFeedback);
+#else
+        float dcCoeff = dtc->dcBlockerCoeff;
+        const _seymourRing* feedbackRing = pThis->feedbackDelayBuffer;
+        float* channelBlock = dtc->blockChannel;
+        float* tapBlock = dtc->blockTap;
+
+        // Silence at the end of each lane before this chunk is written
+        uint32_t silentBefore[kNumChannels];
+        bool lanesSilent = true;
+        for (int ch = 0; ch < kNumChannels; ++ch) {
+            silentBefore[ch] = pThis->silentFrames[ch];
+            if (silentBefore[ch] < pThis->tapReach[ch]) lanesSilent = false;
+        }
+
+        // Process each channel
+        for (int ch = 0; ch < kNumChannels; ++ch) {
+            const _seymourChannelControl& cc = pThis->channelControl[ch];
+
+            // Ring topology: each channel receives feedback from the previous channel
+            // Ch 0 <- Ch N-1, Ch 1 <- Ch 0, Ch 2 <- Ch 1, etc.
+            const int feedbackSourceCh = (ch == 0) ? kNumChannels - 1 : ch - 1;
+            bool tapsSilent = tapsMixed ? lanesSilent : silentBefore[feedbackSourceCh] >= pThis->tapReach[feedbackSourceCh];
+
+            // Idle channel: no input, a settled pan, and every tap it reads
+            // this chunk and its DC blocker are silent, so it contributes
+            // nothing. Its lane only needs zeros until the whole ring is silent.
+            if (cc.inputBus < 0 && !cc.panCVConnected && pThis->panSmoothed[ch] == cc.pan
+                && tapsSilent
+                && fabsf(pThis->dcBlockerX1[ch]) < kSilenceThresholdVolts
+                && fabsf(pThis->dcBlockerY1[ch]) < kSilenceThresholdVolts) {
+                pThis->dcBlockerX1[ch] = 0.0f;
+                pThis->dcBlockerY1[ch] = 0.0f;
+                if (pThis->silentFrames[ch] < feedbackRing[ch].frames()) {
+                    memset(channelBlock, 0, n * sizeof(float));
+                    feedbackRing[ch].write(fbWriteStart, channelBlock, n);
+                    pThis->silentFrames[ch] += n;
+                }
+                profile.split(kStageFeedback);
+                continue;
+            }
+
+            // Gather input
+            if (cc.inputBus >= 0) {
+                memcpy(channelBlock, busFrames + cc.inputBus * numFrames + offset, n * sizeof(float));
+            } else {
+                memset(channelBlock, 0, n * sizeof(float));
+            }
+
+            // Feedback pass: DC block the tap and add it to the input
+            float x1 = pThis->dcBlockerX1[ch];
+            float y1 = pThis->dcBlockerY1[ch];
+            const float* taps = pThis->blockLanes[ch];
+            if (!tapsMixed) {
+                readTaps(pThis, feedbackSourceCh, tapBlock, n, fbWriteStart);
+                taps = tapBlock;
+            }
+            float peak = (cascade.step != 0.0f)
+                ? feedbackPass<true>(channelBlock, taps, n, x1, y1, dcCoeff, cascade)
+                : feedbackPass<false>(channelBlock, taps, n, x1, y1, dcCoeff, cascade);
+            feedbackRing[ch].write(fbWriteStart, channelBlock, n);
+            if (peak < kSilenceThresholdVolts) {
+                if (pThis->silentFrames[ch] < feedbackRing[ch].frames()) pThis->silentFrames[ch] += n;
+            } else {
+                pThis->silentFrames[ch] = 0;
+            }
+            pThis->dcBlockerX1[ch] = x1;
+            pThis->dcBlockerY1[ch] = y1;
+            profile.split(kStageFeedback);
+
+            // Pan/mix pass
+            const float* panCV = cc.panCVConnected ? busFrames + cc.panCVBus * numFrames + offset : NULL;
+            panAndMix(pThis, ch, channelBlock, panCV, n);
+            profile.split(kStageMix);
+        }
+#endif
+
+        dtc->feedbackWriteIndex = fbWriteStart + n;
+        dtc->feedbackWritten = pThis->feedbackDelayBuffer[0].addWritten(dtc->feedbackWritten, n);
+
+        // A cascade well above unity can outrun the DC blockers until the
+        // loop overflows. Restart it from silence rather than let inf/NaN
+        // (and the slow arithmetic that comes with it) latch in the state.
+        bool overflowed = false;
+        for (int ch = 0; ch < kNumChannels; ++ch) {
+            if (!isfinite(pThis->dcBlockerX1[ch]) || !isfinite(pThis->dcBlockerY1[ch])) overflowed = true;
+        }
+        if (overflowed) {
+            flushFeedback(pThis);
+            for (int i = 0; i < n; ++i) {
+                if (!isfinite(mixL[i])) mixL[i] = 0.0f;
+                if (!isfinite(mixR[i])) mixR[i] = 0.0f;
+            }
+        }
+        if (!kLite && (!isfinite(dtc->envelope[0]) || !isfinite(dtc->gainReduction[0])
+                       || !isfinite(dtc->envelope[1]) || !isfinite(dtc->gainReduction[1]))) {
+            resetLimiter(pThis);
+        }
+        profile.split(kStageFeedback);
+
+        if (kLite) {
+            runClipper(pThis, n, outL, outR);
+        } else {
+            runSaturation(pThis, n, outL, outR);
+            writeLimiterCVs(pThis, busFrames, numFrames, offset, n);
+        }
+        profile.split(kStageLimiter);
+        offset += n;
+    }
+
+    for (int ch = 0; ch < kNumChannels; ++ch) {
+        flushDenormal(pThis->dcBlockerX1[ch]);
+        flushDenormal(pThis->dcBlockerY1[ch]);
+    }
+    flushDenormal(dtc->envelope[0]);
+    flushDenormal(dtc->envelope[1]);
+
+#if SEYMOUR_INSTRUMENT
+    recordCycles(pThis, profile, numFrames);
+#endif
+}
+
+// Full kernels, then the Lite clipper kernels
+static const _seymourKernel stepKernels[2][kMaxChannels] = {
+    {
+        stepKernel<1, false>, stepKernel<2, false>, stepKernel<3, false>, stepKernel<4, false>,
+        stepKernel<5, false>, stepKernel<6, false>, stepKernel<7, false>, stepKernel<8, false>,
+    },
+    {
+        stepKernel<1, true>, stepKernel<2, true>, stepKernel<3, true>, stepKernel<4, true>,
+        stepKernel<5, true>, stepKernel<6, true>, stepKernel<7, true>, stepKernel<8, true>,
+    },
+};
+
+static _seymourKernel selectKernel(int32_t numChannels, bool lite) {
+    return stepKernels[lite ? 1 : 0][numChannels - 1];
+}
+
+#if SEYMOUR_HOST_TOOLS
+// ============================================================================
+// REFERENCE KERNEL (host tools)
+// ============================================================================
+
+static inline float saturateReference(float x, int mode) {
+    switch (mode) {
+        case kSaturationSoft: return tanhf(x);
+        case kSaturationTube: return (x >= 0.0f) ? tanhf(x * 0.8f) * 1.1f : tanhf(x * 1.2f) * 0.9f;
+        case kSaturationHard: return saturateHard(x);
+        default: return x;
+    }
+}
+
+static inline float clipReference(float x, int mode) {
+    const float span = 1.0f - kClipperKnee;
+    if (mode == kSaturationHard) return saturateHard(x);
+    if (x > kClipperKnee) return kClipperKnee + span * saturateReference((x - kClipperKnee) / span, mode);
+    if (x < -kClipperKnee) return -kClipperKnee + span * saturateReference((x + kClipperKnee) / span, mode);
+    return x;
+}
+
+/**
+ * Feedback taps for one frame as an explicit N x N matrix product
+ */
+static void topologyReference(int topology, int numChannels, const float* lanes, float* taps) {
+    int size = 1;
+    while (size < numChannels) size <<= 1;
+    for (int row = 0; row < numChannels; ++row) {
+        float sum = 0.0f;
+        for (int col = 0; col < numChannels; ++col) {
+            float m;
+            if (topology == kTopologyHadamard) {
+                m = (__builtin_popcount(row & col) & 1) ? -1.0f : 1.0f;
+                m /= sqrtf((float)size);
+            } else if (topology == kTopologyHouseholder) {
+                m = (row == col ? 1.0f : 0.0f) - 2.0f / numChannels;
+            } else {
+                m = (col == (row - 1 + numChannels) % numChannels) ? 1.0f : 0.0f;
+            }
+            sum += m * lanes[col];
+        }
+        taps[row] = sum;
+    }
+}
+
+/**
+ * Oversampled saturation of one frame, with the decimators always running
+ */
+static void oversampleReference(_seymourAlgorithm* pThis, float& left, float& right,
+                                float thresholdL, float thresholdR, int mode) {
+    _seymourDTC* dtc = pThis->dtc;
+    int factor = dtc->oversampleFactor;
+    pThis->oversampler[0].threshold[kOversampleHistory] = thresholdL;
+    pThis->oversampler[1].threshold[kOversampleHistory] = thresholdR;
+    pThis->oversampler[0].limited[kOversampleHistory] = left;
+    pThis->oversampler[1].limited[kOversampleHistory] = right;
+
+    int shift = factor == 4 ? 2 : 1;
+    int align = factor == 4 ? kHalfbandTapsA + kHalfbandTapsB / 2 : kHalfbandTapsA;
+    float* outputs[2] = { &left, &right };
+    for (int side = 0; side < 2; ++side) {
+        const float* thresholds = pThis->oversampler[side].threshold + kOversampleHistory;
+        float* signal = oversampleUp(pThis, side, 1);
+        for (int j = 0; j < factor; ++j) {
+            float t = thresholds[(j >> shift) - align];
+            signal[j] = (t != 0.0f) ? saturateReference(signal[j] / t, mode) * t - signal[j] : 0.0f;
+        }
+        oversampleDown(pThis, side, 1, outputs[side]);
+    }
+    oversampleAdvance(pThis, 1, true);
+}
+
+/**
+ * The original scalar step(): one frame at a time with every channel inside
+ * it, per-sample one-pole smoothing, cosf/sinf panning, libm tanh, an
+ * unsmoothed master level and the envelope detector updated every frame
+ * for each side of the stereo link. Kept only as the
+ * golden reference the optimised kernels are checked against; it shares
+ * the instance's rings and state but none of their fast paths.
+ */
+static void stepReference(_seymourAlgorithm* pThis, float* busFrames, int numFramesBy4) {
+    _seymourDTC* dtc = pThis->dtc;
+    const _seymourGlobalControl& gc = pThis->globalControl;
+
+    int numFrames = numFramesBy4 * 4;
+    int32_t numChannels = pThis->numChannels;
+
+    float* outL = busFrames + gc.outLBus * numFrames;
+    float* outR = busFrames + gc.outRBus * numFrames;
+
     float dcCoeff = dtc->dcBlockerCoeff;
     float smoothCoeff = dtc->smoothingCoeff;
     float gainSmoothCoeff = dtc->gainSmoothingCoeff;
     float attackCoeff = dtc->envelopeAttack;
     float releaseCoeff = dtc->envelopeRelease;
 
-    // Lookahead buffer
-    float* delayBuf = pThis->lookaheadBuffer;
-    uint32_t bufSize = dtc->bufferSize;
     uint32_t lookahead = dtc->lookaheadSamples;
 
-    // Feedback delay buffer (shared write index, per-channel lanes)
-    float* feedbackDelayBuf = pThis->feedbackDelayBuffer;
-    uint32_t fbBufSize = dtc->feedbackBufferSize;
-    uint32_t fbDelay = dtc->feedbackDelaySamples;
-
-    // Process each sample
     for (int i = 0; i < numFrames; ++i) {
         float mixL = 0.0f;
         float mixR = 0.0f;
 
         // Smooth global parameters (once per sample, not per channel)
-        pThis->cascadeSmoothed += smoothCoeff * (cascadeTarget - pThis->cascadeSmoothed);
-        pThis->squashSmoothed += smoothCoeff * (squashTarget - pThis->squashSmoothed);
+        float& cascade = dtc->cascadeSmoothed.value;
+        float& squash = dtc->squashSmoothed.value;
+        cascade += smoothCoeff * (gc.cascade - cascade);
+        squash += smoothCoeff * (gc.squash - squash);
         float limiterThresholdVolts =
-            kLimiterThresholdMaxVolts - (kLimiterThresholdMaxVolts - kLimiterThresholdMinVolts) * pThis->squashSmoothed;
+            kLimiterThresholdMaxVolts - (kLimiterThresholdMaxVolts - kLimiterThresholdMinVolts) * squash;
 
         uint32_t fbWriteIdx = dtc->feedbackWriteIndex;
-        uint32_t fbReadIdx = (fbWriteIdx + fbBufSize - fbDelay) % fbBufSize;
 
-        // Process each channel
+        // Each lane read at its own delay, linearly interpolated; Delay CV
+        // is applied per sample without smoothing
+        float lanes[kMaxChannels], taps[kMaxChannels];
         for (int32_t ch = 0; ch < numChannels; ++ch) {
-            int paramBase = ch * kNumPerChannelParameters;
-
-            // Get input
-            int inBus = pThis->v[paramBase + kChParamInput] - 1;
-            float input = (inBus >= 0) ? busFrames[inBus * numFrames + i] : 0.0f;
-
-            // Cascade topology: each channel receives feedback from the previous channel
-            // Ch 0 <- Ch N-1, Ch 1 <- Ch 0, Ch 2 <- Ch 1, etc. (ring)
-            int feedbackSourceCh = (ch - 1 + numChannels) % numChannels;
-            float feedbackTap = feedbackDelayBuf[fbReadIdx * kMaxChannels + feedbackSourceCh];
-
-            // DC blocker on feedback to prevent runaway
-            float feedbackFiltered = dcBlock(feedbackTap, pThis->dcBlockerX1[ch], pThis->dcBlockerY1[ch], dcCoeff);
+            const _seymourChannelControl& cc = pThis->channelControl[ch];
+            float delay = baseTapDelay(pThis, ch);
+            if (cc.delayCVConnected) {
+                delay *= 1.0f + busFrames[cc.delayCVBus * numFrames + i] / 5.0f * cc.delayCVDepth;
+                if (delay < kMinTapDelayFrames) delay = kMinTapDelayFrames;
+                if (delay > maxTapDelay(pThis)) delay = maxTapDelay(pThis);
+            }
+            uint32_t whole = (uint32_t)delay;
+            float frac = delay - whole;
+            const _seymourRing& ring = pThis->feedbackDelayBuffer[ch];
+            float newer = ring.at(fbWriteIdx - whole);
+            lanes[ch] = newer + frac * (ring.at(fbWriteIdx - whole - 1) - newer);
+        }
+        topologyReference(gc.topology, numChannels, lanes, taps);
 
-            // Add cascade feedback from previous channel
-            float processed = input + feedbackFiltered * pThis->cascadeSmoothed;
+        for (int32_t ch = 0; ch < numChannels; ++ch) {
+            const _seymourChannelControl& cc = pThis->channelControl[ch];
 
-            feedbackDelayBuf[fbWriteIdx * kMaxChannels + ch] = processed;
+            float input = (cc.inputBus >= 0) ? busFrames[cc.inputBus * numFrames + i] : 0.0f;
 
-            // Get pan with CV
-            float panBase = (float)pThis->v[paramBase + kChParamPan];
-            int panCVBus = pThis->v[paramBase + kChParamPanCV] - 1;
-            float panCVDepth = pThis->v[paramBase + kChParamPanCVDepth] / 100.0f;
+            float feedbackFiltered = dcBlock(taps[ch], pThis->dcBlockerX1[ch], pThis->dcBlockerY1[ch], dcCoeff);
+            float processed = input + feedbackFiltered * cascade;
+            pThis->feedbackDelayBuffer[ch].at(fbWriteIdx) = processed;
 
-            if (panCVBus >= 0) {
-                float cv = busFrames[panCVBus * numFrames + i] / 5.0f;
-                panBase += cv * 100.0f * panCVDepth;
+            float panBase = cc.pan;
+            if (cc.panCVConnected) {
+                float cv = busFrames[cc.panCVBus * numFrames + i] / 5.0f;
+                panBase += cv * 100.0f * cc.panCVDepth;
                 if (panBase < -100.0f) panBase = -100.0f;
                 if (panBase > 100.0f) panBase = 100.0f;
             }
-
-            // Smooth pan
             pThis->panSmoothed[ch] += smoothCoeff * (panBase - pThis->panSmoothed[ch]);
 
-            // Apply panning
             float gainL, gainR;
             equalPowerPan(pThis->panSmoothed[ch], gainL, gainR);
-
             mixL += processed * gainL;
             mixR += processed * gainR;
         }
 
-        dtc->feedbackWriteIndex = (dtc->feedbackWriteIndex + 1) % fbBufSize;
+        dtc->feedbackWriteIndex = fbWriteIdx + 1;
+
+        mixL *= gc.masterLevel;
+        mixR *= gc.masterLevel;
+
+        float finalL, finalR;
+        if (pThis->lite) {
+            // Lite: the clipper alone, with no lookahead or gain state
+            finalL = clipReference(mixL / limiterThresholdVolts, gc.saturationMode) * limiterThresholdVolts;
+            finalR = clipReference(mixR / limiterThresholdVolts, gc.saturationMode) * limiterThresholdVolts;
+        } else {
+            // Lookahead limiter
+            uint32_t writeIdx = dtc->writeIndex;
+            pThis->lookaheadBuffer[0].at(writeIdx) = mixL;
+            pThis->lookaheadBuffer[1].at(writeIdx) = mixR;
+            float delayedL = pThis->lookaheadBuffer[0].at(writeIdx - lookahead);
+            float delayedR = pThis->lookaheadBuffer[1].at(writeIdx - lookahead);
+            dtc->writeIndex = writeIdx + 1;
+
+            // Detector sides: the louder of L and R, L and R, or mid and side
+            if (dtc->limiterLink != gc.link) linkLimiter(pThis, gc.link);
+            float detect[2];
+            bool saturating[2];
+            if (gc.link == kLinkUnlinked) {
+                detect[0] = fabsf(mixL);
+                detect[1] = fabsf(mixR);
+            } else if (gc.link == kLinkMidSide) {
+                detect[0] = fabsf(mixL + mixR) * 0.5f;
+                detect[1] = fabsf(mixL - mixR) * 0.5f;
+            } else {
+                detect[0] = fabsf(mixL) > fabsf(mixR) ? fabsf(mixL) : fabsf(mixR);
+            }
+            int numSides = (gc.link == kLinkLinked) ? 1 : 2;
+            for (int side = 0; side < numSides; ++side) {
+                float& envelope = dtc->envelope[side];
+                float& gain = dtc->gainReduction[side];
+                float envCoeff = (detect[side] > envelope) ? attackCoeff : releaseCoeff;
+                envelope += envCoeff * (detect[side] - envelope);
+
+                float targetGain = 1.0f;
+                if (envelope > limiterThresholdVolts) {
+                    targetGain = limiterThresholdVolts / envelope;
+                }
+                gain += gainSmoothCoeff * (targetGain - gain);
+                saturating[side] = gain < 0.9999f || envelope > limiterThresholdVolts;
+            }
 
-        // Master level
-        mixL *= masterTarget;
-        mixR *= masterTarget;
+            bool saturatingL = saturating[0];
+            bool saturatingR = saturating[numSides - 1];
+            if (gc.link == kLinkMidSide) {
+                float mid = (delayedL + delayedR) * 0.5f * dtc->gainReduction[0];
+                float side = (delayedL - delayedR) * 0.5f * dtc->gainReduction[1];
+                finalL = mid + side;
+                finalR = mid - side;
+                saturatingL = saturatingR = saturating[0] || saturating[1];
+            } else {
+                finalL = delayedL * dtc->gainReduction[0];
+                finalR = delayedR * dtc->gainReduction[numSides - 1];
+            }
+            if (gc.oversample > 1) {
+                if (dtc->oversampleFactor != gc.oversample) setupOversampler(pThis, gc.oversample);
+                oversampleReference(pThis, finalL, finalR, saturatingL ? limiterThresholdVolts : 0.0f,
+                                    saturatingR ? limiterThresholdVolts : 0.0f, gc.saturationMode);
+            } else {
+                if (saturatingL) finalL = saturateReference(finalL / limiterThresholdVolts, gc.saturationMode) * limiterThresholdVolts;
+                if (saturatingR) finalR = saturateReference(finalR / limiterThresholdVolts, gc.saturationMode) * limiterThresholdVolts;
+            }
+        }
 
-        // Lookahead limiter
-        uint32_t writeIdx = dtc->writeIndex;
-        delayBuf[writeIdx * 2] = mixL;
-        delayBuf[writeIdx * 2 + 1] = mixR;
+        if (gc.replaceL) outL[i] = finalL;
+        else outL[i] += finalL;
 
-        uint32_t readIdx = (writeIdx + bufSize - lookahead) % bufSize;
-        float delayedL = delayBuf[readIdx * 2];
-        float delayedR = delayBuf[readIdx * 2 + 1];
+        if (gc.replaceR) outR[i] = finalR;
+        else outR[i] += finalR;
+    }
+}
 
-        float absL = mixL > 0 ? mixL : -mixL;
-        float absR = mixR > 0 ? mixR : -mixR;
-        float peakIn = absL > absR ? absL : absR;
+void seymourSelectKernel(_NT_algorithm* self, int kernel) {
+    _seymourAlgorithm* pThis = (_seymourAlgorithm*)self;
+    pThis->kernel = (kernel == kSeymourKernelReference) ? stepReference : selectKernel(pThis->numChannels, pThis->lite);
+}
+#endif
 
-        float envCoeff = (peakIn > dtc->envelope) ? attackCoeff : releaseCoeff;
-        dtc->envelope += envCoeff * (peakIn - dtc->envelope);
+/**
+ * Follow a change of the system sample rate in place, without rebuilding
+ * the instance: recompute the coefficients and delay lengths, and rescale
+ * the smoothed tap delays so a modulated lane keeps its time instead of
+ * slewing there. The rings, their free-running positions and the limiter
+ * state carry straight on; the audio already in the rings plays out once
+ * at the new rate. The rings keep the length they were sized for, so at a
+ * higher rate than at construction the delays are limited to what they hold.
+ */
+static void reconfigureSampleRate(_seymourAlgorithm* pThis) {
+    _seymourDTC* dtc = pThis->dtc;
+    int globalBase = pThis->numChannels * kNumPerChannelParameters;
+    float ratio = (float)NT_globals.sampleRate / dtc->sampleRate;
 
-        float targetGain = 1.0f;
-        if (dtc->envelope > limiterThresholdVolts) {
-            targetGain = limiterThresholdVolts / dtc->envelope;
-        }
+    setRateCoefficients(dtc);
+    if (!pThis->lite) {
+        dtc->lookaheadSamples = delayParameterFrames(pThis->v[globalBase + kParamLookahead], pThis->lookaheadBuffer[0]);
+    }
+    dtc->feedbackDelaySamples = delayParameterFrames(pThis->v[globalBase + kParamFeedbackDelay], pThis->feedbackDelayBuffer[0]);
+
+    float longest = maxTapDelay(pThis);
+    for (int ch = 0; ch < pThis->numChannels; ++ch) {
+        float delay = pThis->delaySmoothed[ch] * ratio;
+        if (delay < kMinTapDelayFrames) delay = kMinTapDelayFrames;
+        if (delay > longest) delay = longest;
+        pThis->delaySmoothed[ch] = delay;
+    }
+}
 
-        dtc->gainReduction += gainSmoothCoeff * (targetGain - dtc->gainReduction);
+/**
+ * Read a JSON array of numbers into the first count entries of values;
+ * elements beyond them are read and dropped
+ */
+static bool parseNumbers(_NT_jsonParse& parse, float* values, int count) {
+    int numElements;
+    if (!parse.numberOfArrayElements(numElements)) return false;
+    for (int i = 0; i < numElements; ++i) {
+        float value;
+        if (!parse.number(value)) return false;
+        if (i < count) values[i] = value;
+    }
+    return true;
+}
 
-        float limitedL = delayedL * dtc->gainReduction;
-        float limitedR = delayedR * dtc->gainReduction;
+static void addNumbers(_NT_jsonStream& stream, const char* name, const float* values, int count) {
+    stream.addMemberName(name);
+    stream.openArray();
+    for (int i = 0; i < count; ++i) {
+        stream.addNumber(values[i]);
+    }
+    stream.closeArray();
+}
 
-        float finalL = limitedL;
-        float finalR = limitedR;
-        if (dtc->gainReduction < 0.9999f || dtc->envelope > limiterThresholdVolts) {
-            float normL = limitedL / limiterThresholdVolts;
-            float normR = limitedR / limiterThresholdVolts;
-            finalL = saturate(normL, satMode) * limiterThresholdVolts;
-            finalR = saturate(normR, satMode) * limiterThresholdVolts;
-        }
+/**
+ * Clamp a restored value into range; anything non-finite becomes fallback
+ */
+static inline float restoredValue(float value, float lo, float hi, float fallback) {
+    if (!isfinite(value)) return fallback;
+    return value < lo ? lo : (value > hi ? hi : value);
+}
 
-        dtc->writeIndex = (writeIdx + 1) % bufSize;
+/**
+ * Save the smoothed parameters and the limiter state with the preset, so a
+ * recalled instance starts where the saved one was instead of slewing from
+ * the constructor defaults. The audio in the rings is not saved.
+ */
+void serialise(_NT_algorithm* self, _NT_jsonStream& stream) {
+    _seymourAlgorithm* pThis = (_seymourAlgorithm*)self;
+    const _seymourDTC* dtc = pThis->dtc;
+    int numChannels = pThis->numChannels;
+
+    stream.addMemberName("level");
+    stream.addNumber(dtc->masterLevelSmoothed.value);
+    stream.addMemberName("cascade");
+    stream.addNumber(dtc->cascadeSmoothed.value);
+    stream.addMemberName("squash");
+    stream.addNumber(dtc->squashSmoothed.value);
+    addNumbers(stream, "pan", pThis->panSmoothed, numChannels);
+
+    // Tap delays in ms, so they survive a change of sample rate
+    float delayMs[kMaxChannels];
+    for (int ch = 0; ch < numChannels; ++ch) {
+        delayMs[ch] = pThis->delaySmoothed[ch] * 1000.0f / dtc->sampleRate;
+    }
+    addNumbers(stream, "delay", delayMs, numChannels);
 
-        if (replaceL) outL[i] = finalL;
-        else outL[i] += finalL;
+    if (!pThis->lite) {
+        stream.addMemberName("link");
+        stream.addNumber(dtc->limiterLink);
+        addNumbers(stream, "envelope", dtc->envelope, 2);
+        addNumbers(stream, "gain", dtc->gainReduction, 2);
+    }
+}
 
-        if (replaceR) outR[i] = finalR;
-        else outR[i] += finalR;
+/**
+ * Restore what serialise() saved. Members are optional and checked, and
+ * unknown ones are skipped, so presets from other versions still load.
+ */
+bool deserialise(_NT_algorithm* self, _NT_jsonParse& parse) {
+    _seymourAlgorithm* pThis = (_seymourAlgorithm*)self;
+    _seymourDTC* dtc = pThis->dtc;
+    int numChannels = pThis->numChannels;
+
+    int numMembers;
+    if (!parse.numberOfObjectMembers(numMembers)) return false;
+    for (int member = 0; member < numMembers; ++member) {
+        float values[kMaxChannels];
+        if (parse.matchName("level")) {
+            float value;
+            if (!parse.number(value)) return false;
+            dtc->masterLevelSmoothed.value = restoredValue(value, 0.0f, 1.0f, 1.0f);
+        } else if (parse.matchName("cascade")) {
+            float value;
+            if (!parse.number(value)) return false;
+            dtc->cascadeSmoothed.value = restoredValue(value, 0.0f, 1.5f, 0.0f);
+        } else if (parse.matchName("squash")) {
+            float value;
+            if (!parse.number(value)) return false;
+            dtc->squashSmoothed.value = restoredValue(value, 0.0f, 1.0f, 0.56f);
+        } else if (parse.matchName("pan")) {
+            for (int ch = 0; ch < numChannels; ++ch) values[ch] = pThis->panSmoothed[ch];
+            if (!parseNumbers(parse, values, numChannels)) return false;
+            for (int ch = 0; ch < numChannels; ++ch) {
+                float pan = restoredValue(values[ch], -100.0f, 100.0f, 0.0f);
+                pThis->panSmoothed[ch] = pan;
+                equalPowerPan(pan, pThis->panGainL[ch], pThis->panGainR[ch]);
+            }
+        } else if (parse.matchName("delay")) {
+            for (int ch = 0; ch < numChannels; ++ch) values[ch] = pThis->delaySmoothed[ch] * 1000.0f / dtc->sampleRate;
+            if (!parseNumbers(parse, values, numChannels)) return false;
+            for (int ch = 0; ch < numChannels; ++ch) {
+                float frames = restoredValue(values[ch], 0.0f, (float)kMaxDelayMs, 0.0f) * dtc->sampleRate / 1000.0f;
+                pThis->delaySmoothed[ch] = restoredValue(frames, kMinTapDelayFrames, maxTapDelay(pThis), kMinTapDelayFrames);
+            }
+        } else if (parse.matchName("link")) {
+            int link;
+            if (!parse.number(link)) return false;
+            if (link >= kLinkLinked && link <= kLinkMidSide) dtc->limiterLink = link;
+        } else if (parse.matchName("envelope")) {
+            for (int side = 0; side < 2; ++side) values[side] = dtc->envelope[side];
+            if (!parseNumbers(parse, values, 2)) return false;
+            for (int side = 0; side < 2; ++side) {
+                dtc->envelope[side] = restoredValue(values[side], 0.0f, HUGE_VALF, 0.0f);
+            }
+        } else if (parse.matchName("gain")) {
+            for (int side = 0; side < 2; ++side) values[side] = dtc->gainReduction[side];
+            if (!parseNumbers(parse, values, 2)) return false;
+            for (int side = 0; side < 2; ++side) {
+                dtc->gainReduction[side] = restoredValue(values[side], 0.0f, 1.0f, 1.0f);
+            }
+        } else if (!parse.skipMember()) {
+            return false;
+        }
     }
+    return true;
+}
+
+void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
+    _seymourAlgorithm* pThis = (_seymourAlgorithm*)self;
+    _seymourDenormalGuard denormalGuard;
+    if (pThis->dtc->sampleRate != NT_globals.sampleRate) reconfigureSampleRate(pThis);
+    pThis->kernel(pThis, busFrames, numFramesBy4);
+}
+
+#if SEYMOUR_INSTRUMENT
+/**
+ * Append "label value" to a display line
+ */
+static int appendField(char* line, int len, const char* label, uint32_t value) {
+    while (*label) line[len++] = *label++;
+    len += NT_intToString(line + len, (int32_t)value);
+    line[len++] = ' ';
+    line[len] = 0;
+    return len;
+}
+
+/**
+ * Horizontal meter, amount 0..1 of width pixels
+ */
+static void drawMeter(int x, int y, int width, const char* label, float amount) {
+    if (amount < 0.0f) amount = 0.0f;
+    if (amount > 1.0f) amount = 1.0f;
+    NT_drawText(x, y + 6, label, 15, kNT_textLeft, kNT_textTiny);
+    NT_drawShapeI(kNT_box, x + 20, y, x + 20 + width, y + 6, 8);
+    NT_drawShapeI(kNT_rectangle, x + 20, y, x + 20 + (int)(amount * width), y + 6, 15);
+}
+
+/**
+ * Instrumentation display: step() cycles (min/avg/max), the per-stage split,
+ * the share of the audio budget, and the limiter's gain reduction (0..-20dB)
+ * and envelope (relative to the threshold)
+ */
+bool draw(_NT_algorithm* self) {
+    _seymourAlgorithm* pThis = (_seymourAlgorithm*)self;
+    const _seymourCycleStats& c = pThis->cycles;
+    const _seymourDTC* dtc = pThis->dtc;
+    char line[64];
+    int len;
+
+    line[0] = 0;
+    len = appendField(line, 0, "step min ", c.shownMin);
+    len = appendField(line, len, "avg ", c.shownAvg);
+    appendField(line, len, "max ", c.shownMax);
+    NT_drawText(0, 20, line, 15, kNT_textLeft, kNT_textTiny);
+
+    len = appendField(line, 0, "mix ", c.shownStage[kStageMix]);
+    len = appendField(line, len, "fb ", c.shownStage[kStageFeedback]);
+    appendField(line, len, "lim ", c.shownStage[kStageLimiter]);
+    NT_drawText(0, 30, line, 15, kNT_textLeft, kNT_textTiny);
+
+    // Budget: cycles per frame against the core clock per sample period
+    uint32_t budget = SEYMOUR_CPU_HZ / NT_globals.sampleRate;
+    len = appendField(line, 0, "cyc/frame ", c.shownPerFrame);
+    appendField(line, len, "cpu% ", budget ? (c.shownPerFrame * 100 + budget / 2) / budget : 0);
+    NT_drawText(0, 40, line, 15, kNT_textLeft, kNT_textTiny);
+
+    float gainReduction, envelope;
+    limiterLevels(dtc, gainReduction, envelope);
+    float grDb = -20.0f * log10f(gainReduction > 1.0e-6f ? gainReduction : 1.0e-6f);
+    drawMeter(0, 46, 100, "GR", grDb / 20.0f);
+    drawMeter(128, 46, 100, "Env", envelope / dtc->thresholdRamp.to);
+
+    return false;
 }
+#endif
 
 // ============================================================================
 // FACTORY
@@ -571,21 +3495,25 @@ static const _NT_factory factory = {
     .description = "Feedback mixer with safety limiter",
     .numSpecifications = ARRAY_SIZE(specifications),
     .specifications = specifications,
-    .calculateStaticRequirements = NULL,
-    .initialise = NULL,
+    .calculateStaticRequirements = calculateStaticRequirements,
+    .initialise = initialise,
     .calculateRequirements = calculateRequirements,
     .construct = construct,
     .parameterChanged = parameterChanged,
     .step = step,
+#if SEYMOUR_INSTRUMENT
+    .draw = draw,
+#else
     .draw = NULL,
+#endif
     .midiRealtime = NULL,
     .midiMessage = NULL,
     .tags = kNT_tagEffect | kNT_tagUtility,
     .hasCustomUi = NULL,
     .customUi = NULL,
     .setupUi = NULL,
-    .serialise = NULL,
-    .deserialise = NULL,
+    .serialise = serialise,
+    .deserialise = deserialise,
     .midiSysEx = NULL,
     .parameterUiPrefix = parameterUiPrefix,
 };
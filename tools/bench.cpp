@@ -0,0 +1,391 @@
+/*
+ * Seymour benchmark - runs step() on synthetic busses across the main
+ * configurations and reports the cost per frame and of the slowest block.
+ *
+ * Usage: bench [options] [seconds per case] [block frames] [sample rate]
+ *   -S           run the fixed perf-suite matrix instead of the full sweep:
+ *                Full and Lite, inputs 1/2/4/8, every saturation mode,
+ *                Cascade 0/100/150%, static and CV pan, at 48 and 96 kHz
+ *                (or only at the rate given)
+ *   -n runs      runs per case (default 3); each case reports its fastest
+ *                mean and its worst block as below
+ *   -o file      write a machine-readable report (tab-separated, one row per case)
+ *   -B file      compare against a report from an earlier run on the same
+ *                machine and exit with status 1 if a case regressed; cases
+ *                over a threshold are measured twice more after the pass,
+ *                and only count if their best figures are still over
+ *   -x percent   allowed rise in ns/frame against -B (default 10)
+ *   -w percent   allowed rise in the worst block against -B (default 25)
+ *   -m points    ...and only if it also takes more of the block's time, in
+ *                percentage points of the budget (default 0.25)
+ *
+ * The audio busses carry a sine plus noise at a few volts on every input, so
+ * the limiter works and the idle paths stay out of the way; CV-panned cases
+ * drive each Pan CV from its own slow LFO. Only the step() calls are timed,
+ * each one separately, with std::chrono. On hardware the same figures come
+ * from DWT cycle counts in the instrumentation build (see README).
+ *
+ * Every run of a case feeds step() the same busses, so block n costs the
+ * same each time up to whatever else the machine was doing. The worst block
+ * is therefore the slowest of the blocks' fastest times over the runs: a
+ * block that is slow every time (the first one, on cold caches) still shows,
+ * a one-off preemption does not.
+ */
+
+#include "nt_host.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+enum {
+    kFirstInputBus = 0,     // inputs on busses 1..8
+    kFirstCVBus = 20,       // pan CVs on busses 21..28
+};
+
+static const char* const saturationNames[] = { "Soft", "Tube", "Hard" };
+static const char* const specNames[] = { "full", "lite" };
+static const int cascades[] = { 0, 100, 150 };
+static const int suiteInputs[] = { 1, 2, 4, 8 };
+static const uint32_t suiteRates[] = { 48000, 96000 };
+
+struct BenchCase {
+    int lite;
+    uint32_t sampleRate;
+    int inputs;
+    int saturation;
+    int cascade;
+    int cv;
+};
+
+struct BenchResult {
+    double nsPerFrame;          // fastest mean over the runs
+    double worstBlockNs;        // slowest block, each at its fastest over the runs
+};
+
+struct BaselineRow {
+    std::string key;
+    double nsPerFrame;
+    double worstBlockNs;
+};
+
+/**
+ * Fill numFrames frames of every bus, continuing from frame position pos
+ */
+static void fillBusses(float* busFrames, int numFrames, uint32_t pos, uint32_t sampleRate, uint32_t& rng) {
+    for (int b = 0; b < kNtHostNumBusses; ++b) {
+        float* bus = busFrames + b * numFrames;
+        for (int i = 0; i < numFrames; ++i) {
+            float t = (float)(pos + i) / sampleRate;
+            if (b < kFirstCVBus) {
+                rng = rng * 1664525u + 1013904223u;
+                float noise = (rng >> 8) / 16777216.0f - 0.5f;
+                bus[i] = 3.0f * sinf(6.28318f * 110.0f * (b + 1) * t) + 2.0f * noise;
+            } else {
+                bus[i] = 5.0f * sinf(6.28318f * 0.5f * (b - kFirstCVBus + 1) * t);
+            }
+        }
+    }
+}
+
+/**
+ * One second of busses at the given rate, pre-rendered so generating them
+ * is not timed
+ */
+static void makeSource(std::vector<float>& source, int blockFrames, uint32_t sampleRate) {
+    int blocksPerSecond = (int)(sampleRate / blockFrames);
+    source.resize((size_t)blocksPerSecond * kNtHostNumBusses * blockFrames);
+    uint32_t rng = 1;
+    for (int blk = 0; blk < blocksPerSecond; ++blk) {
+        fillBusses(&source[(size_t)blk * kNtHostNumBusses * blockFrames], blockFrames, blk * blockFrames, sampleRate, rng);
+    }
+}
+
+/**
+ * Report key of a case: everything but the measurements
+ */
+static std::string caseKey(const BenchCase& c, int blockFrames) {
+    char key[128];
+    snprintf(key, sizeof(key), "%s\t%u\t%d\t%d\t%s\t%d\t%s", specNames[c.lite], c.sampleRate, blockFrames, c.inputs,
+             saturationNames[c.saturation], c.cascade, c.cv ? "cv" : "static");
+    return key;
+}
+
+static bool runCase(const BenchCase& c, int blockFrames, float seconds, int runs, const std::vector<float>& source,
+                    BenchResult& result) {
+    int blocksPerSecond = (int)(c.sampleRate / blockFrames);
+    int totalBlocks = (int)(seconds * c.sampleRate / blockFrames);
+    if (totalBlocks < 1) totalBlocks = 1;
+    std::vector<float> busFrames(kNtHostNumBusses * blockFrames);
+
+    std::vector<double> fastestBlock(totalBlocks, HUGE_VAL);
+    result.nsPerFrame = 0.0;
+    for (int run = 0; run < runs; ++run) {
+        NtHostInstance instance;
+        int32_t specs[] = { c.inputs, 20, c.lite, 0, 0 };   // the other specifications at their defaults
+        if (!instance.create(specs)) {
+            fprintf(stderr, "bench: construct failed (%d inputs, %s)\n", c.inputs, specNames[c.lite]);
+            return false;
+        }
+        instance.setParameter("Out L mode", 1);
+        instance.setParameter("Out R mode", 1);
+        instance.setParameter("Saturation", c.saturation);
+        instance.setParameter("Cascade", c.cascade);
+        for (int ch = 0; ch < c.inputs; ++ch) {
+            instance.setParameter("Input", kFirstInputBus + ch + 1, ch);
+            instance.setParameter("Pan", -80 + ch * 160 / 8, ch);
+            instance.setParameter("Pan CV", c.cv ? kFirstCVBus + ch + 1 : 0, ch);
+        }
+
+        double elapsed = 0.0;
+        for (int blk = 0; blk < totalBlocks; ++blk) {
+            const float* src = &source[(size_t)(blk % blocksPerSecond) * kNtHostNumBusses * blockFrames];
+            memcpy(&busFrames[0], src, busFrames.size() * sizeof(float));
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            instance.step(&busFrames[0], blockFrames);
+            double block = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            elapsed += block;
+            if (block < fastestBlock[blk]) fastestBlock[blk] = block;
+        }
+
+        double nsPerFrame = elapsed * 1e9 / ((double)totalBlocks * blockFrames);
+        if (run == 0 || nsPerFrame < result.nsPerFrame) result.nsPerFrame = nsPerFrame;
+    }
+
+    result.worstBlockNs = 0.0;
+    for (int blk = 0; blk < totalBlocks; ++blk) {
+        if (fastestBlock[blk] * 1e9 > result.worstBlockNs) result.worstBlockNs = fastestBlock[blk] * 1e9;
+    }
+    return true;
+}
+
+/**
+ * Read a report written by -o
+ */
+static bool readBaseline(const char* path, std::vector<BaselineRow>& rows) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "bench: cannot open baseline %s\n", path);
+        return false;
+    }
+    char line[256];
+    bool header = true;
+    while (fgets(line, sizeof(line), f)) {
+        if (header) {
+            header = false;
+            continue;
+        }
+        // Seven key columns, then ns/frame and the worst block
+        char* p = line;
+        for (int column = 0; column < 7 && p; ++column) {
+            p = strchr(p, '\t');
+            if (p) ++p;
+        }
+        if (!p) continue;
+        BaselineRow row;
+        row.key.assign(line, p - 1 - line);
+        if (sscanf(p, "%lf\t%lf", &row.nsPerFrame, &row.worstBlockNs) != 2) continue;
+        rows.push_back(row);
+    }
+    fclose(f);
+    return true;
+}
+
+// Extra passes over the cases still above a threshold before they count
+enum { kConfirmRetries = 2 };
+
+/**
+ * Percentage rise of value over base
+ */
+static double rise(double value, double base) {
+    return (value / base - 1.0) * 100.0;
+}
+
+/**
+ * Regression thresholds against a baseline
+ */
+struct Tolerances {
+    double mean;            // percent rise in ns/frame
+    double worst;           // percent rise in the worst block...
+    double worstPoints;     // ...that is also this many points of the block's budget
+};
+
+static bool regressed(const BenchResult& result, const BaselineRow& base, double blockNs, const Tolerances& tol) {
+    if (rise(result.nsPerFrame, base.nsPerFrame) > tol.mean) return true;
+    double worstPoints = (result.worstBlockNs - base.worstBlockNs) * 100.0 / blockNs;
+    return rise(result.worstBlockNs, base.worstBlockNs) > tol.worst && worstPoints > tol.worstPoints;
+}
+
+/**
+ * Time the audio of one block lasts
+ */
+static double blockBudgetNs(const BenchCase& c, int blockFrames) {
+    return blockFrames * 1e9 / c.sampleRate;
+}
+
+/**
+ * Worst block as a share of the block's budget
+ */
+static double worstBudget(const BenchResult& result, const BenchCase& c, int blockFrames) {
+    return result.worstBlockNs * 100.0 / blockBudgetNs(c, blockFrames);
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [-S] [-n runs] [-o report] [-B baseline] [-x percent] [-w percent] [-m points]\n"
+                    "       [seconds per case] [block frames, multiple of 4] [sample rate]\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    bool suite = false;
+    int runs = 3;
+    const char* reportPath = NULL;
+    const char* baselinePath = NULL;
+    Tolerances tolerances = { 10.0, 25.0, 0.25 };
+
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-' && argv[arg][1]; ++arg) {
+        char option = argv[arg][1];
+        if (option == 'S') {
+            suite = true;
+            continue;
+        }
+        if (arg + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        const char* value = argv[++arg];
+        switch (option) {
+            case 'n': runs = atoi(value); break;
+            case 'o': reportPath = value; break;
+            case 'B': baselinePath = value; break;
+            case 'x': tolerances.mean = atof(value); break;
+            case 'w': tolerances.worst = atof(value); break;
+            case 'm': tolerances.worstPoints = atof(value); break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    float seconds = (arg < argc) ? (float)atof(argv[arg]) : 1.0f;
+    int blockFrames = (arg + 1 < argc) ? atoi(argv[arg + 1]) : 32;
+    uint32_t sampleRate = (arg + 2 < argc) ? (uint32_t)atoi(argv[arg + 2]) : 0;
+    if (seconds <= 0.0f || blockFrames < 4 || (blockFrames & 3) || runs < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+    ntHostSetMaxFramesPerStep(blockFrames);
+
+    std::vector<BaselineRow> baseline;
+    if (baselinePath && !readBaseline(baselinePath, baseline)) return 1;
+
+    // The cases, in report order
+    std::vector<BenchCase> cases;
+    std::vector<uint32_t> rates;
+    if (sampleRate) {
+        rates.push_back(sampleRate);
+    } else if (suite) {
+        rates.assign(suiteRates, suiteRates + ARRAY_SIZE(suiteRates));
+    } else {
+        rates.push_back(48000);
+    }
+    for (int lite = 0; lite <= (suite ? 1 : 0); ++lite) {
+        for (size_t r = 0; r < rates.size(); ++r) {
+            int numInputs = suite ? (int)ARRAY_SIZE(suiteInputs) : 8;
+            for (int in = 0; in < numInputs; ++in) {
+                for (int sat = 0; sat < 3; ++sat) {
+                    for (unsigned c = 0; c < ARRAY_SIZE(cascades); ++c) {
+                        for (int cv = 0; cv <= 1; ++cv) {
+                            BenchCase bc = { lite, rates[r], suite ? suiteInputs[in] : in + 1, sat, cascades[c], cv };
+                            cases.push_back(bc);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    printf("# Seymour bench: %d-frame blocks, %.2f s per case, best of %d runs\n", blockFrames, seconds, runs);
+    printf("%-4s %-6s %-6s %-10s %-7s %-6s %10s %14s %10s %10s %8s\n", "spec", "rate", "inputs", "saturation", "cascade",
+           "pan", "ns/frame", "frames/s", "x realtime", "worst us", "worst %");
+
+    std::vector<BenchResult> results(cases.size());
+    std::vector<const BaselineRow*> bases(cases.size());
+    std::vector<float> source;
+    uint32_t sourceRate = 0;
+    for (size_t i = 0; i < cases.size(); ++i) {
+        const BenchCase& c = cases[i];
+        if (c.sampleRate != sourceRate) {
+            ntHostSetSampleRate(c.sampleRate);
+            makeSource(source, blockFrames, c.sampleRate);
+            sourceRate = c.sampleRate;
+        }
+        BenchResult& result = results[i];
+        if (!runCase(c, blockFrames, seconds, runs, source, result)) return 1;
+
+        std::string key = caseKey(c, blockFrames);
+        bases[i] = NULL;
+        for (size_t b = 0; b < baseline.size() && !bases[i]; ++b) {
+            if (baseline[b].key == key) bases[i] = &baseline[b];
+        }
+
+        double framesPerSecond = 1e9 / result.nsPerFrame;
+        printf("%-4s %-6u %-6d %-10s %-7d %-6s %10.1f %14.0f %10.1f %10.2f %8.2f\n", specNames[c.lite], c.sampleRate,
+               c.inputs, saturationNames[c.saturation], c.cascade, c.cv ? "cv" : "static", result.nsPerFrame,
+               framesPerSecond, framesPerSecond / c.sampleRate, result.worstBlockNs / 1000.0,
+               worstBudget(result, c, blockFrames));
+    }
+
+    // Cases over the threshold are measured again after the whole pass, so a
+    // regression has to show every time and not just while the machine was
+    // busy for a moment
+    for (int retry = 0; retry < kConfirmRetries; ++retry) {
+        for (size_t i = 0; i < cases.size(); ++i) {
+            const BenchCase& c = cases[i];
+            if (!bases[i] || !regressed(results[i], *bases[i], blockBudgetNs(c, blockFrames), tolerances)) continue;
+            ntHostSetSampleRate(c.sampleRate);
+            makeSource(source, blockFrames, c.sampleRate);
+            BenchResult again;
+            if (!runCase(c, blockFrames, seconds, runs, source, again)) return 1;
+            if (again.nsPerFrame < results[i].nsPerFrame) results[i].nsPerFrame = again.nsPerFrame;
+            if (again.worstBlockNs < results[i].worstBlockNs) results[i].worstBlockNs = again.worstBlockNs;
+        }
+    }
+
+    int regressions = 0;
+    for (size_t i = 0; i < cases.size(); ++i) {
+        const BaselineRow* base = bases[i];
+        if (!base || !regressed(results[i], *base, blockBudgetNs(cases[i], blockFrames), tolerances)) continue;
+        printf("REGRESSION: %s: ns/frame %.1f -> %.1f (%+.0f%%), worst block %.0f -> %.0f ns (%+.0f%%)\n",
+               base->key.c_str(), base->nsPerFrame, results[i].nsPerFrame, rise(results[i].nsPerFrame, base->nsPerFrame),
+               base->worstBlockNs, results[i].worstBlockNs, rise(results[i].worstBlockNs, base->worstBlockNs));
+        ++regressions;
+    }
+
+    if (reportPath) {
+        FILE* report = fopen(reportPath, "w");
+        if (!report) {
+            fprintf(stderr, "bench: cannot create %s\n", reportPath);
+            return 1;
+        }
+        fprintf(report, "spec\trate\tblock\tinputs\tsaturation\tcascade\tpan\tns_per_frame\tworst_block_ns\tworst_budget_pct\n");
+        for (size_t i = 0; i < cases.size(); ++i) {
+            fprintf(report, "%s\t%.1f\t%.0f\t%.2f\n", caseKey(cases[i], blockFrames).c_str(), results[i].nsPerFrame,
+                    results[i].worstBlockNs, worstBudget(results[i], cases[i], blockFrames));
+        }
+        fclose(report);
+    }
+
+    if (baselinePath) {
+        if (regressions) {
+            printf("FAIL: %d case(s) regressed (ns/frame above +%.0f%%, or worst block above +%.0f%% and +%.2f points)\n",
+                   regressions, tolerances.mean, tolerances.worst, tolerances.worstPoints);
+            return 1;
+        }
+        printf("PASS\n");
+    }
+    return 0;
+}
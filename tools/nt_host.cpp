@@ -0,0 +1,490 @@
+/*
+ * Minimal desktop host - see nt_host.h
+ */
+
+#include "nt_host.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <vector>
+
+// ============================================================================
+// FIRMWARE SYMBOLS
+// ============================================================================
+
+static _NT_globals makeGlobals() {
+    _NT_globals globals;
+    memset(&globals, 0, sizeof(globals));
+    globals.sampleRate = 48000;
+    globals.maxFramesPerStep = 128;
+    return globals;
+}
+
+// Dynamically initialised, so it lives in writable memory and the setters
+// below can adjust it before the plug-in reads it
+const _NT_globals NT_globals = makeGlobals();
+
+uint8_t NT_screen[128 * 64 / 2];
+
+void ntHostSetSampleRate(uint32_t sampleRate) {
+    const_cast<_NT_globals&>(NT_globals).sampleRate = sampleRate;
+}
+
+void ntHostSetMaxFramesPerStep(uint32_t maxFramesPerStep) {
+    const_cast<_NT_globals&>(NT_globals).maxFramesPerStep = maxFramesPerStep;
+}
+
+int NT_intToString(char* buffer, int32_t value) {
+    return sprintf(buffer, "%d", (int)value);
+}
+
+int NT_floatToString(char* buffer, float value, int decimalPlaces) {
+    return sprintf(buffer, "%.*f", decimalPlaces, value);
+}
+
+void NT_drawText(int x, int y, const char* str, int colour, _NT_textAlignment align, _NT_textSize size) {}
+void NT_drawShapeI(_NT_shape shape, int x0, int y0, int x1, int y1, int colour) {}
+void NT_drawShapeF(_NT_shape shape, float x0, float y0, float x1, float y1, float colour) {}
+
+// ============================================================================
+// JSON
+// ============================================================================
+
+// The firmware owns _NT_jsonStream and _NT_jsonParse and keeps their
+// constructors to itself; the host lays out the same members (a refCon, and
+// for the parser a token index) and copies them into storage for the class.
+struct NtHostJsonStream {
+    void* refCon;
+};
+
+struct NtHostJsonParse {
+    void* refCon;
+    int i;
+};
+
+template <typename Firmware, typename Host>
+struct NtHostFirmwareObject {
+    union {
+        void* align;
+        unsigned char bytes[sizeof(Firmware) > sizeof(Host) ? sizeof(Firmware) : sizeof(Host)];
+    };
+
+    explicit NtHostFirmwareObject(const Host& members) {
+        memcpy(bytes, &members, sizeof(members));
+    }
+
+    Firmware& get() { return *(Firmware*)bytes; }
+};
+
+/**
+ * JSON text being written by serialise()
+ */
+struct NtHostJsonWriter {
+    std::string text;
+    bool first;         // nothing written yet at this level, so no comma
+    bool afterName;     // a member name is waiting for its value
+
+    NtHostJsonWriter() : first(true), afterName(false) {}
+
+    void beginValue() {
+        if (!first && !afterName) text += ',';
+        first = false;
+        afterName = false;
+    }
+};
+
+static NtHostJsonWriter& writer(void* refCon) {
+    return *(NtHostJsonWriter*)refCon;
+}
+
+static void appendString(std::string& text, const char* str) {
+    text += '"';
+    for (; *str; ++str) {
+        if (*str == '"' || *str == '\\') text += '\\';
+        text += *str;
+    }
+    text += '"';
+}
+
+void _NT_jsonStream::openArray() {
+    writer(refCon).beginValue();
+    writer(refCon).text += '[';
+    writer(refCon).first = true;
+}
+
+void _NT_jsonStream::closeArray() {
+    writer(refCon).text += ']';
+    writer(refCon).first = false;
+}
+
+void _NT_jsonStream::openObject() {
+    writer(refCon).beginValue();
+    writer(refCon).text += '{';
+    writer(refCon).first = true;
+}
+
+void _NT_jsonStream::closeObject() {
+    writer(refCon).text += '}';
+    writer(refCon).first = false;
+}
+
+void _NT_jsonStream::addMemberName(const char* name) {
+    NtHostJsonWriter& w = writer(refCon);
+    w.beginValue();
+    appendString(w.text, name);
+    w.text += ':';
+    w.afterName = true;
+}
+
+void _NT_jsonStream::addNumber(int value) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%d", value);
+    writer(refCon).beginValue();
+    writer(refCon).text += buffer;
+}
+
+void _NT_jsonStream::addNumber(float value) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.9g", value);    // enough digits to read back the same float
+    writer(refCon).beginValue();
+    writer(refCon).text += buffer;
+}
+
+void _NT_jsonStream::addString(const char* str) {
+    writer(refCon).beginValue();
+    appendString(writer(refCon).text, str);
+}
+
+void _NT_jsonStream::addFourCC(uint32_t fourcc) {
+    char buffer[5] = { (char)(fourcc >> 24), (char)(fourcc >> 16), (char)(fourcc >> 8), (char)fourcc, 0 };
+    addString(buffer);
+}
+
+void _NT_jsonStream::addBoolean(bool value) {
+    writer(refCon).beginValue();
+    writer(refCon).text += value ? "true" : "false";
+}
+
+void _NT_jsonStream::addNull() {
+    writer(refCon).beginValue();
+    writer(refCon).text += "null";
+}
+
+/**
+ * A parsed JSON document as a flat list of tokens, in document order, which
+ * _NT_jsonParse walks with its index
+ */
+struct NtHostJsonToken {
+    enum Type { kObject, kArray, kString, kPrimitive } type;
+    int size;           // members of an object, elements of an array
+    int next;           // index of the token after this one and everything inside it
+    std::string text;   // string contents, or the primitive as written
+};
+
+struct NtHostJsonDocument {
+    std::vector<NtHostJsonToken> tokens;
+    const char* p;
+
+    static bool isDelimiter(char c) {
+        return c == ',' || c == ':' || c == ']' || c == '}' || c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == 0;
+    }
+
+    void skipSpace() {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') ++p;
+    }
+
+    int add(NtHostJsonToken::Type type) {
+        NtHostJsonToken token;
+        token.type = type;
+        token.size = 0;
+        token.next = 0;
+        tokens.push_back(token);
+        return (int)tokens.size() - 1;
+    }
+
+    bool parseString() {
+        if (*p++ != '"') return false;
+        int t = add(NtHostJsonToken::kString);
+        std::string text;
+        while (*p != '"') {
+            if (*p == 0) return false;
+            if (*p == '\\') {
+                ++p;
+                if (*p == 0) return false;
+                text += (*p == 'n') ? '\n' : (*p == 't') ? '\t' : *p;
+            } else {
+                text += *p;
+            }
+            ++p;
+        }
+        ++p;
+        tokens[t].text = text;
+        tokens[t].next = (int)tokens.size();
+        return true;
+    }
+
+    bool parseValue() {
+        skipSpace();
+        if (*p == '"') return parseString();
+        if (*p == '{' || *p == '[') {
+            bool object = (*p++ == '{');
+            char close = object ? '}' : ']';
+            int t = add(object ? NtHostJsonToken::kObject : NtHostJsonToken::kArray);
+            skipSpace();
+            int size = 0;
+            if (*p == close) {
+                ++p;
+            } else {
+                for (;;) {
+                    if (object) {
+                        skipSpace();
+                        if (!parseString()) return false;
+                        skipSpace();
+                        if (*p++ != ':') return false;
+                    }
+                    if (!parseValue()) return false;
+                    ++size;
+                    skipSpace();
+                    if (*p == ',') {
+                        ++p;
+                    } else if (*p++ == close) {
+                        break;
+                    } else {
+                        return false;
+                    }
+                }
+            }
+            tokens[t].size = size;
+            tokens[t].next = (int)tokens.size();
+            return true;
+        }
+        const char* start = p;
+        while (!isDelimiter(*p)) ++p;
+        if (p == start) return false;
+        int t = add(NtHostJsonToken::kPrimitive);
+        tokens[t].text.assign(start, p - start);
+        tokens[t].next = (int)tokens.size();
+        return true;
+    }
+
+    bool parse(const std::string& json) {
+        tokens.clear();
+        p = json.c_str();
+        if (!parseValue()) return false;
+        skipSpace();
+        return *p == 0;
+    }
+};
+
+static const NtHostJsonToken* token(void* refCon, int i) {
+    const NtHostJsonDocument& document = *(const NtHostJsonDocument*)refCon;
+    return (i >= 0 && i < (int)document.tokens.size()) ? &document.tokens[i] : NULL;
+}
+
+bool _NT_jsonParse::numberOfObjectMembers(int& num) {
+    const NtHostJsonToken* t = token(refCon, i);
+    if (!t || t->type != NtHostJsonToken::kObject) return false;
+    num = t->size;
+    ++i;
+    return true;
+}
+
+bool _NT_jsonParse::numberOfArrayElements(int& num) {
+    const NtHostJsonToken* t = token(refCon, i);
+    if (!t || t->type != NtHostJsonToken::kArray) return false;
+    num = t->size;
+    ++i;
+    return true;
+}
+
+bool _NT_jsonParse::matchName(const char* name) {
+    const NtHostJsonToken* t = token(refCon, i);
+    if (!t || t->type != NtHostJsonToken::kString || t->text != name) return false;
+    ++i;
+    return true;
+}
+
+bool _NT_jsonParse::skipMember() {
+    const NtHostJsonToken* name = token(refCon, i);
+    if (!name || name->type != NtHostJsonToken::kString) return false;
+    const NtHostJsonToken* value = token(refCon, i + 1);
+    if (!value) return false;
+    i = value->next;
+    return true;
+}
+
+bool _NT_jsonParse::number(int& value) {
+    float f;
+    if (!number(f)) return false;
+    value = (int)f;
+    return true;
+}
+
+bool _NT_jsonParse::number(float& value) {
+    const NtHostJsonToken* t = token(refCon, i);
+    if (!t || t->type != NtHostJsonToken::kPrimitive) return false;
+    char* end;
+    value = strtof(t->text.c_str(), &end);
+    if (*end != 0) return false;
+    ++i;
+    return true;
+}
+
+bool _NT_jsonParse::string(const char*& str) {
+    const NtHostJsonToken* t = token(refCon, i);
+    if (!t || t->type != NtHostJsonToken::kString) return false;
+    str = t->text.c_str();
+    ++i;
+    return true;
+}
+
+bool _NT_jsonParse::boolean(bool& value) {
+    const NtHostJsonToken* t = token(refCon, i);
+    if (!t || t->type != NtHostJsonToken::kPrimitive || (t->text != "true" && t->text != "false")) return false;
+    value = (t->text == "true");
+    ++i;
+    return true;
+}
+
+bool _NT_jsonParse::null() {
+    const NtHostJsonToken* t = token(refCon, i);
+    if (!t || t->type != NtHostJsonToken::kPrimitive || t->text != "null") return false;
+    ++i;
+    return true;
+}
+
+// ============================================================================
+// INSTANCE
+// ============================================================================
+
+// Shared (static) memory, set up once per process as the firmware does
+static uint8_t* staticMemory = NULL;
+
+NtHostInstance::NtHostInstance() : factory(NULL), algorithm(NULL), values(NULL) {
+    memset(&requirements, 0, sizeof(requirements));
+    memset(memory, 0, sizeof(memory));
+}
+
+NtHostInstance::~NtHostInstance() {
+    destroy();
+}
+
+bool NtHostInstance::create(const int32_t* specifications) {
+    destroy();
+
+    factory = (const _NT_factory*)pluginEntry(kNT_selector_factoryInfo, 0);
+    if (!factory) return false;
+
+    int32_t defaults[8];
+    if (!specifications) {
+        for (uint32_t i = 0; i < factory->numSpecifications && i < ARRAY_SIZE(defaults); ++i) {
+            defaults[i] = factory->specifications[i].def;
+        }
+        specifications = defaults;
+    }
+
+    if (factory->calculateStaticRequirements && !staticMemory) {
+        _NT_staticRequirements staticReq;
+        memset(&staticReq, 0, sizeof(staticReq));
+        factory->calculateStaticRequirements(staticReq);
+        staticMemory = (uint8_t*)calloc(staticReq.dram + 1, 1);
+        _NT_staticMemoryPtrs staticPtrs = { staticMemory };
+        if (factory->initialise) factory->initialise(staticPtrs, staticReq);
+    }
+
+    factory->calculateRequirements(requirements, specifications);
+    uint32_t sizes[4] = { requirements.sram, requirements.dram, requirements.dtc, requirements.itc };
+    for (int i = 0; i < 4; ++i) {
+        // Written rather than calloc()ed, so the pages are mapped before the
+        // first step() and timing it does not pay for page faults
+        memory[i] = (uint8_t*)malloc(sizes[i] + 1);
+        if (memory[i]) memset(memory[i], 0, sizes[i] + 1);
+    }
+    _NT_algorithmMemoryPtrs ptrs = { memory[0], memory[1], memory[2], memory[3] };
+
+    algorithm = factory->construct(ptrs, requirements, specifications);
+    if (!algorithm) {
+        destroy();
+        return false;
+    }
+
+    values = (int16_t*)calloc(requirements.numParameters + 1, sizeof(int16_t));
+    for (int p = 0; p < numParameters(); ++p) {
+        values[p] = algorithm->parameters[p].def;
+    }
+    algorithm->v = values;
+    algorithm->vIncludingCommon = values;
+    for (int p = 0; p < numParameters(); ++p) {
+        factory->parameterChanged(algorithm, p);
+    }
+    return true;
+}
+
+void NtHostInstance::destroy() {
+    if (algorithm) {
+        algorithm->~_NT_algorithm();
+        algorithm = NULL;
+    }
+    for (int i = 0; i < 4; ++i) {
+        free(memory[i]);
+        memory[i] = NULL;
+    }
+    free(values);
+    values = NULL;
+}
+
+int NtHostInstance::findParameter(const char* name, int occurrence) const {
+    for (int p = 0; p < numParameters(); ++p) {
+        if (strcmp(algorithm->parameters[p].name, name) == 0 && occurrence-- == 0) return p;
+    }
+    return -1;
+}
+
+void NtHostInstance::setParameter(int p, int value) {
+    const _NT_parameter& param = algorithm->parameters[p];
+    if (value < param.min) value = param.min;
+    if (value > param.max) value = param.max;
+    values[p] = (int16_t)value;
+    factory->parameterChanged(algorithm, p);
+}
+
+bool NtHostInstance::setParameter(const char* name, int value, int occurrence) {
+    int p = findParameter(name, occurrence);
+    if (p < 0) {
+        fprintf(stderr, "nt_host: no parameter \"%s\" (%d)\n", name, occurrence);
+        return false;
+    }
+    setParameter(p, value);
+    return true;
+}
+
+void NtHostInstance::step(float* busFrames, int numFrames) {
+    factory->step(algorithm, busFrames, numFrames / 4);
+}
+
+bool NtHostInstance::saveState(std::string& json) {
+    if (!factory->serialise) return false;
+    NtHostJsonWriter w;
+    NtHostJsonStream members = { &w };
+    NtHostFirmwareObject<_NT_jsonStream, NtHostJsonStream> stream(members);
+    _NT_jsonStream& jsonStream = stream.get();
+    jsonStream.openObject();
+    factory->serialise(algorithm, jsonStream);
+    jsonStream.closeObject();
+    json = w.text;
+    return true;
+}
+
+bool NtHostInstance::restoreState(const std::string& json) {
+    if (!factory->deserialise) return false;
+    NtHostJsonDocument document;
+    if (!document.parse(json)) {
+        fprintf(stderr, "nt_host: state does not parse: %s\n", json.c_str());
+        return false;
+    }
+    NtHostJsonParse members = { &document, 0 };
+    NtHostFirmwareObject<_NT_jsonParse, NtHostJsonParse> parse(members);
+    return factory->deserialise(algorithm, parse.get());
+}
@@ -0,0 +1,84 @@
+/*
+ * Minimal desktop host for running the plug-in outside the distingNT and
+ * nt_emu: provides the NT_globals / NT_* symbols the firmware normally
+ * exports and drives one algorithm instance through the factory callbacks.
+ * Used by the tools in this directory only - never part of a plug-in build.
+ */
+
+#ifndef SEYMOUR_NT_HOST_H
+#define SEYMOUR_NT_HOST_H
+
+#include <distingnt/api.h>
+
+#include <string>
+
+// Busses the firmware provides (1-based in parameters, 0-based here)
+enum { kNtHostNumBusses = 28 };
+
+/**
+ * Set NT_globals.sampleRate. Instances pick up a change at their next
+ * step().
+ */
+void ntHostSetSampleRate(uint32_t sampleRate);
+
+/**
+ * Set NT_globals.maxFramesPerStep. Only valid before any instance is created.
+ */
+void ntHostSetMaxFramesPerStep(uint32_t maxFramesPerStep);
+
+/**
+ * One algorithm instance with its own memory regions and parameter values
+ */
+struct NtHostInstance {
+    const _NT_factory* factory;
+    _NT_algorithm* algorithm;
+    _NT_algorithmRequirements requirements;
+    int16_t* values;
+    uint8_t* memory[4];     // sram, dram, dtc, itc
+
+    NtHostInstance();
+    ~NtHostInstance();
+
+    /**
+     * Construct the plug-in's first factory with the given specifications
+     * (NULL for the defaults) and push every parameter default through
+     * parameterChanged(). Returns false on failure.
+     */
+    bool create(const int32_t* specifications);
+    void destroy();
+
+    int numParameters() const { return (int)requirements.numParameters; }
+
+    /**
+     * Index of the occurrence'th parameter called name, or -1. Per-channel
+     * parameters share a name, so occurrence picks the channel.
+     */
+    int findParameter(const char* name, int occurrence = 0) const;
+
+    /**
+     * Set a parameter (clamped to its range) and notify the algorithm
+     */
+    void setParameter(int p, int value);
+    bool setParameter(const char* name, int value, int occurrence = 0);
+
+    /**
+     * Run step() over numFrames frames (a multiple of 4) of busFrames, laid
+     * out as kNtHostNumBusses consecutive runs of numFrames samples
+     */
+    void step(float* busFrames, int numFrames);
+
+    /**
+     * Run the factory's serialise() into a JSON object, as the firmware does
+     * when a preset is saved. Returns false if the plug-in has no serialise().
+     */
+    bool saveState(std::string& json);
+
+    /**
+     * Hand a JSON object from saveState() to deserialise(), as the firmware
+     * does after a preset's parameters are loaded. Returns false if the text
+     * does not parse or deserialise() rejects it.
+     */
+    bool restoreState(const std::string& json);
+};
+
+#endif // SEYMOUR_NT_HOST_H
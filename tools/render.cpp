@@ -0,0 +1,348 @@
+/*
+ * Seymour offline render and regression check.
+ *
+ * Streams a WAV file (or a synthetic test signal) through two instances of
+ * the plug-in - one on the optimised step kernels, one on the original
+ * scalar reference step() - at any block size and sample rate, then reports
+ * the error between them and the throughput of each.
+ *
+ * Usage: render [options] [input.wav]
+ *   -o out.wav        write the optimised output (stereo, 32-bit float)
+ *   -R ref.wav        write the reference output
+ *   -b frames         block size, a multiple of 4 (default 32)
+ *   -r rate           sample rate given to the plug-in (default: the file's, else 48000)
+ *   -i inputs         Inputs specification (default: the file's channel count, max 8; 2 if synthetic)
+ *   -d ms             Max delay specification (default 20)
+ *   -l 0|1            Lite specification (default 0, Full)
+ *   -O 0|1|2          Max oversample specification (default 0, Off)
+ *   -W 0|1            Window detector specification (default 0)
+ *   -a 0|1            1: put Out L / Out R on input busses 1 and 2, so the
+ *                     plug-in processes in place (default 0: busses 13, 14)
+ *   -c rate           switch the system sample rate to this halfway through,
+ *                     without rebuilding the instances
+ *   -w 0|1            1: halfway through, save each instance's state, build a
+ *                     fresh instance with the same setup and restore it, as
+ *                     recalling a preset does (default 0)
+ *   -s seconds        synthetic input length when no file is given (default 5)
+ *   -p Name=value     set a parameter before rendering; Name#N=value sets channel N's copy
+ *   -t volts          exit with status 1 if the max-abs error exceeds this
+ *   -e volts          exit with status 1 if the RMS error exceeds this
+ *
+ * Input channel n feeds Seymour input n (bus n); full scale is 5V. The
+ * outputs run in Replace mode unless -p says otherwise. Non-finite output
+ * from the optimised kernels always fails; the reference is known to
+ * overflow on a sustained Cascade above ~120%, and those frames are left
+ * out of the comparison and counted.
+ *
+ * The optimised kernels are not meant to be bit-exact (block smoothing, fast
+ * tanh), and the limiter switches saturation on and off at a hard gain
+ * threshold, so an isolated sample can differ by a large step when the two
+ * kernels cross it one frame apart. -e is therefore the better gate; -t
+ * catches gross breakage, and render-check sets it loosely at 1V.
+ */
+
+#include "nt_host.h"
+#include "seymour_host.h"
+#include "wav.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+static const float kVoltsPerFullScale = 5.0f;
+
+enum { kMaxParameterOptions = 64 };
+
+struct RenderOptions {
+    const char* inputPath;
+    const char* outputPath;
+    const char* referencePath;
+    int blockFrames;
+    uint32_t sampleRate;
+    int inputs;
+    int maxDelayMs;
+    int lite;
+    int maxOversample;
+    int windowDetector;
+    int inPlace;
+    uint32_t changeRate;        // 0: keep the rate
+    int recall;
+    float syntheticSeconds;
+    float tolerance;            // max-abs, < 0: report only
+    float rmsTolerance;         // < 0: report only
+    int numParameters;
+    const char* parameters[kMaxParameterOptions];
+};
+
+struct RenderResult {
+    std::vector<float> output;  // interleaved stereo, volts
+    double seconds;             // time spent in step()
+};
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [-o out.wav] [-R ref.wav] [-b frames] [-r rate] [-i inputs] [-d ms]\n"
+                    "       [-l 0|1] [-O 0|1|2] [-W 0|1] [-a 0|1] [-c rate] [-w 0|1] [-s seconds] [-p Name[#N]=value]... [-t volts] [-e volts] [input.wav]\n", argv0);
+}
+
+/**
+ * Bursts of sine plus noise on each input in turn, so the cascade, the
+ * limiter and the idle paths all get exercised
+ */
+static void makeSynthetic(WavData& wav, int channels, uint32_t sampleRate, float seconds) {
+    wav.sampleRate = sampleRate;
+    wav.numChannels = channels;
+    size_t frames = (size_t)(seconds * sampleRate);
+    wav.samples.resize(frames * channels);
+    uint32_t rng = 1;
+    for (size_t t = 0; t < frames; ++t) {
+        for (int ch = 0; ch < channels; ++ch) {
+            rng = rng * 1664525u + 1013904223u;
+            float noise = (rng >> 8) / 16777216.0f - 0.5f;
+            bool on = ((t / (sampleRate / 5)) % 3) == (size_t)(ch % 3);
+            float s = on ? 0.8f * sinf(6.28318f * 110.0f * (ch + 1) * t / sampleRate) + 0.6f * noise : 0.0f;
+            wav.samples[t * channels + ch] = s;
+        }
+    }
+}
+
+/**
+ * Apply one -p option ("Name=value" or "Name#N=value")
+ */
+static bool applyParameter(NtHostInstance& instance, const char* option) {
+    char name[64];
+    const char* eq = strchr(option, '=');
+    if (!eq || eq == option || (size_t)(eq - option) >= sizeof(name)) {
+        fprintf(stderr, "render: bad parameter option \"%s\"\n", option);
+        return false;
+    }
+    memcpy(name, option, eq - option);
+    name[eq - option] = 0;
+    int occurrence = 0;
+    char* hash = strchr(name, '#');
+    if (hash) {
+        *hash = 0;
+        occurrence = atoi(hash + 1) - 1;
+    }
+    return instance.setParameter(name, atoi(eq + 1), occurrence);
+}
+
+/**
+ * Construct an instance and set it up for the render: kernel, outputs,
+ * inputs and the -p options
+ */
+static bool setup(NtHostInstance& instance, const RenderOptions& opt, const WavData& input, int kernel) {
+    int32_t specs[] = { opt.inputs, opt.maxDelayMs, opt.lite, opt.maxOversample, opt.windowDetector };
+    if (!instance.create(specs)) {
+        fprintf(stderr, "render: construct failed\n");
+        return false;
+    }
+    seymourSelectKernel(instance.algorithm, kernel);
+
+    instance.setParameter("Out L mode", 1);
+    instance.setParameter("Out R mode", 1);
+    if (opt.inPlace) {
+        instance.setParameter("Out L", 1);
+        instance.setParameter("Out R", 2);
+    }
+    for (int ch = 0; ch < opt.inputs; ++ch) {
+        instance.setParameter("Input", ch < input.numChannels ? ch + 1 : 0, ch);
+    }
+    for (int i = 0; i < opt.numParameters; ++i) {
+        if (!applyParameter(instance, opt.parameters[i])) return false;
+    }
+    return true;
+}
+
+static bool render(const RenderOptions& opt, const WavData& input, int kernel, RenderResult& result) {
+    ntHostSetSampleRate(opt.sampleRate);
+    NtHostInstance instance;
+    if (!setup(instance, opt, input, kernel)) return false;
+
+    int outL = instance.algorithm->v[instance.findParameter("Out L")] - 1;
+    int outR = instance.algorithm->v[instance.findParameter("Out R")] - 1;
+
+    int block = opt.blockFrames;
+    size_t frames = input.numFrames();
+    std::vector<float> busFrames((size_t)kNtHostNumBusses * block);
+    result.output.assign(frames * 2, 0.0f);
+    result.seconds = 0.0;
+
+    size_t changeAt = opt.changeRate ? frames / 2 : frames;
+    size_t recallAt = opt.recall ? frames / 2 : frames;
+    for (size_t start = 0; start < frames; start += block) {
+        size_t n = frames - start;
+        if (n > (size_t)block) n = block;
+        if (start >= changeAt) {
+            ntHostSetSampleRate(opt.changeRate);
+            changeAt = frames;
+        }
+        if (start >= recallAt) {
+            std::string state;
+            if (!instance.saveState(state) || !setup(instance, opt, input, kernel) || !instance.restoreState(state)) {
+                fprintf(stderr, "render: state recall failed\n");
+                return false;
+            }
+            recallAt = frames;
+        }
+
+        memset(&busFrames[0], 0, busFrames.size() * sizeof(float));
+        for (int ch = 0; ch < input.numChannels && ch < kNtHostNumBusses; ++ch) {
+            float* bus = &busFrames[(size_t)ch * block];
+            for (size_t i = 0; i < n; ++i) {
+                bus[i] = input.samples[(start + i) * input.numChannels + ch] * kVoltsPerFullScale;
+            }
+        }
+
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        instance.step(&busFrames[0], block);
+        result.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        for (size_t i = 0; i < n; ++i) {
+            result.output[(start + i) * 2] = (outL >= 0) ? busFrames[(size_t)outL * block + i] : 0.0f;
+            result.output[(start + i) * 2 + 1] = (outR >= 0) ? busFrames[(size_t)outR * block + i] : 0.0f;
+        }
+    }
+    return true;
+}
+
+static bool writeOutput(const char* path, const RenderResult& result, uint32_t sampleRate) {
+    WavData wav;
+    wav.sampleRate = sampleRate;
+    wav.numChannels = 2;
+    wav.samples.resize(result.output.size());
+    for (size_t i = 0; i < result.output.size(); ++i) {
+        wav.samples[i] = result.output[i] / kVoltsPerFullScale;
+    }
+    return wavWrite(path, wav);
+}
+
+static double dbfs(double volts) {
+    return (volts > 0.0) ? 20.0 * log10(volts / kVoltsPerFullScale) : -INFINITY;
+}
+
+int main(int argc, char** argv) {
+    RenderOptions opt;
+    memset(&opt, 0, sizeof(opt));
+    opt.blockFrames = 32;
+    opt.maxDelayMs = 20;
+    opt.syntheticSeconds = 5.0f;
+    opt.tolerance = -1.0f;
+    opt.rmsTolerance = -1.0f;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (arg[0] != '-') {
+            opt.inputPath = arg;
+            continue;
+        }
+        if (i + 1 >= argc || arg[2] != 0) {
+            usage(argv[0]);
+            return 2;
+        }
+        const char* value = argv[++i];
+        switch (arg[1]) {
+            case 'o': opt.outputPath = value; break;
+            case 'R': opt.referencePath = value; break;
+            case 'b': opt.blockFrames = atoi(value); break;
+            case 'r': opt.sampleRate = (uint32_t)atoi(value); break;
+            case 'i': opt.inputs = atoi(value); break;
+            case 'd': opt.maxDelayMs = atoi(value); break;
+            case 'l': opt.lite = atoi(value); break;
+            case 'O': opt.maxOversample = atoi(value); break;
+            case 'W': opt.windowDetector = atoi(value); break;
+            case 'a': opt.inPlace = atoi(value); break;
+            case 'c': opt.changeRate = (uint32_t)atoi(value); break;
+            case 'w': opt.recall = atoi(value); break;
+            case 's': opt.syntheticSeconds = (float)atof(value); break;
+            case 't': opt.tolerance = (float)atof(value); break;
+            case 'e': opt.rmsTolerance = (float)atof(value); break;
+            case 'p':
+                if (opt.numParameters == kMaxParameterOptions) {
+                    fprintf(stderr, "render: too many -p options\n");
+                    return 2;
+                }
+                opt.parameters[opt.numParameters++] = value;
+                break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if (opt.blockFrames < 4 || (opt.blockFrames & 3)) {
+        fprintf(stderr, "render: block size must be a positive multiple of 4\n");
+        return 2;
+    }
+
+    WavData input;
+    if (opt.inputPath) {
+        if (!wavRead(opt.inputPath, input)) return 2;
+        if (!opt.sampleRate) opt.sampleRate = input.sampleRate;
+        if (!opt.inputs) opt.inputs = input.numChannels < 8 ? input.numChannels : 8;
+    } else {
+        if (!opt.sampleRate) opt.sampleRate = 48000;
+        if (!opt.inputs) opt.inputs = 2;
+        makeSynthetic(input, opt.inputs, opt.sampleRate, opt.syntheticSeconds);
+    }
+    if (opt.inputs < 1 || opt.inputs > 8 || input.numFrames() == 0) {
+        fprintf(stderr, "render: need 1-8 inputs and some audio\n");
+        return 2;
+    }
+    ntHostSetMaxFramesPerStep(opt.blockFrames);
+
+    RenderResult optimised, reference;
+    if (!render(opt, input, kSeymourKernelOptimised, optimised)) return 2;
+    if (!render(opt, input, kSeymourKernelReference, reference)) return 2;
+
+    // Error of the optimised kernels against the reference
+    double maxAbs = 0.0, sumSquares = 0.0;
+    size_t firstOver = (size_t)-1, compared = 0, nonFinite = 0, referenceNonFinite = 0;
+    for (size_t i = 0; i < optimised.output.size(); ++i) {
+        float a = optimised.output[i];
+        float b = reference.output[i];
+        if (!isfinite(a)) ++nonFinite;
+        if (!isfinite(b)) ++referenceNonFinite;
+        if (!isfinite(a) || !isfinite(b)) continue;
+        double d = fabs((double)a - b);
+        if (d > maxAbs) maxAbs = d;
+        if (opt.tolerance >= 0.0f && d > opt.tolerance && firstOver == (size_t)-1) firstOver = i / 2;
+        sumSquares += d * d;
+        ++compared;
+    }
+    double rms = compared ? sqrt(sumSquares / compared) : 0.0;
+
+    size_t frames = input.numFrames();
+    printf("# Seymour render: %s, %zu frames, %d inputs, %u Hz, %d-frame blocks\n",
+           opt.inputPath ? opt.inputPath : "synthetic", frames, opt.inputs, opt.sampleRate, opt.blockFrames);
+    printf("%-10s %10s %10s\n", "kernel", "ns/frame", "x realtime");
+    const RenderResult* results[] = { &optimised, &reference };
+    const char* names[] = { "optimised", "reference" };
+    for (int k = 0; k < 2; ++k) {
+        double seconds = results[k]->seconds;
+        printf("%-10s %10.1f %10.1f\n", names[k], seconds * 1e9 / frames, frames / seconds / opt.sampleRate);
+    }
+    printf("error: max-abs %.3g V (%.1f dBFS), rms %.3g V (%.1f dBFS)\n", maxAbs, dbfs(maxAbs), rms, dbfs(rms));
+    printf("non-finite samples: optimised %zu, reference %zu\n", nonFinite, referenceNonFinite);
+
+    if (opt.outputPath && !writeOutput(opt.outputPath, optimised, opt.sampleRate)) return 2;
+    if (opt.referencePath && !writeOutput(opt.referencePath, reference, opt.sampleRate)) return 2;
+
+    bool failed = false;
+    if (nonFinite) {
+        printf("FAIL: non-finite output\n");
+        failed = true;
+    }
+    if (opt.tolerance >= 0.0f && maxAbs > opt.tolerance) {
+        printf("FAIL: max-abs error above %.3g V from frame %zu\n", opt.tolerance, firstOver);
+        failed = true;
+    }
+    if (opt.rmsTolerance >= 0.0f && rms > opt.rmsTolerance) {
+        printf("FAIL: rms error above %.3g V\n", opt.rmsTolerance);
+        failed = true;
+    }
+    if (failed) return 1;
+    if (opt.tolerance >= 0.0f || opt.rmsTolerance >= 0.0f) printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,22 @@
+/*
+ * Seymour entry points for the host tools. Only compiled into the plug-in
+ * when SEYMOUR_HOST_TOOLS is set (see src/seymour.cpp).
+ */
+
+#ifndef SEYMOUR_HOST_H
+#define SEYMOUR_HOST_H
+
+#include <distingnt/api.h>
+
+enum SeymourKernel {
+    kSeymourKernelOptimised,    // the step kernels the plug-in ships with
+    kSeymourKernelReference,    // the original scalar per-sample step()
+};
+
+/**
+ * Switch an instance between kernels. Call right after construction, before
+ * the first step(), so both kernels start from the same state.
+ */
+void seymourSelectKernel(_NT_algorithm* self, int kernel);
+
+#endif // SEYMOUR_HOST_H
@@ -0,0 +1,131 @@
+/*
+ * Minimal WAV file reader/writer - see wav.h
+ */
+
+#include "wav.h"
+
+#include <stdio.h>
+#include <string.h>
+
+enum {
+    kWavFormatPCM = 1,
+    kWavFormatFloat = 3,
+    kWavFormatExtensible = 0xFFFE,
+};
+
+static uint32_t readLE(const uint8_t* p, int bytes) {
+    uint32_t value = 0;
+    for (int i = bytes - 1; i >= 0; --i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+static void writeLE(FILE* f, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        fputc((value >> (8 * i)) & 0xFF, f);
+    }
+}
+
+bool wavRead(const char* path, WavData& wav) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "wav: cannot open %s\n", path);
+        return false;
+    }
+    std::vector<uint8_t> file;
+    uint8_t chunk[65536];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        file.insert(file.end(), chunk, chunk + got);
+    }
+    fclose(f);
+
+    if (file.size() < 12 || memcmp(&file[0], "RIFF", 4) != 0 || memcmp(&file[8], "WAVE", 4) != 0) {
+        fprintf(stderr, "wav: %s is not a RIFF/WAVE file\n", path);
+        return false;
+    }
+
+    int format = 0;
+    int bits = 0;
+    const uint8_t* data = NULL;
+    size_t dataBytes = 0;
+    wav.numChannels = 0;
+
+    // Walk the chunks for "fmt " and "data"
+    size_t pos = 12;
+    while (pos + 8 <= file.size()) {
+        const uint8_t* id = &file[pos];
+        size_t size = readLE(&file[pos + 4], 4);
+        size_t body = pos + 8;
+        if (body + size > file.size()) size = file.size() - body;
+        if (memcmp(id, "fmt ", 4) == 0 && size >= 16) {
+            format = (int)readLE(&file[body], 2);
+            wav.numChannels = (int)readLE(&file[body + 2], 2);
+            wav.sampleRate = readLE(&file[body + 4], 4);
+            bits = (int)readLE(&file[body + 14], 2);
+            if (format == kWavFormatExtensible && size >= 26) {
+                format = (int)readLE(&file[body + 24], 2);   // SubFormat GUID starts with the format tag
+            }
+        } else if (memcmp(id, "data", 4) == 0) {
+            data = &file[body];
+            dataBytes = size;
+        }
+        pos = body + size + (size & 1);
+    }
+
+    bool supported = (format == kWavFormatPCM && (bits == 16 || bits == 24 || bits == 32))
+        || (format == kWavFormatFloat && bits == 32);
+    if (!data || wav.numChannels <= 0 || wav.sampleRate == 0 || !supported) {
+        fprintf(stderr, "wav: %s: unsupported format (%d, %d-bit) or missing data\n", path, format, bits);
+        return false;
+    }
+
+    int bytes = bits / 8;
+    size_t count = dataBytes / bytes;
+    count -= count % wav.numChannels;
+    wav.samples.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* p = data + i * bytes;
+        uint32_t raw = readLE(p, bytes);
+        float value;
+        if (format == kWavFormatFloat) {
+            memcpy(&value, &raw, sizeof(value));
+        } else {
+            // Sign-extend to 32 bits, then scale to -1..1
+            int32_t s = (int32_t)(raw << (32 - bits));
+            value = (float)s / 2147483648.0f;
+        }
+        wav.samples[i] = value;
+    }
+    return true;
+}
+
+bool wavWrite(const char* path, const WavData& wav) {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        fprintf(stderr, "wav: cannot create %s\n", path);
+        return false;
+    }
+    uint32_t dataBytes = (uint32_t)(wav.samples.size() * sizeof(float));
+    fwrite("RIFF", 1, 4, f);
+    writeLE(f, 36 + dataBytes, 4);
+    fwrite("WAVEfmt ", 1, 8, f);
+    writeLE(f, 16, 4);
+    writeLE(f, kWavFormatFloat, 2);
+    writeLE(f, wav.numChannels, 2);
+    writeLE(f, wav.sampleRate, 4);
+    writeLE(f, wav.sampleRate * wav.numChannels * 4, 4);
+    writeLE(f, wav.numChannels * 4, 2);
+    writeLE(f, 32, 2);
+    fwrite("data", 1, 4, f);
+    writeLE(f, dataBytes, 4);
+    for (size_t i = 0; i < wav.samples.size(); ++i) {
+        uint32_t raw;
+        memcpy(&raw, &wav.samples[i], sizeof(raw));
+        writeLE(f, raw, 4);
+    }
+    bool ok = (ferror(f) == 0);
+    fclose(f);
+    return ok;
+}
@@ -0,0 +1,34 @@
+/*
+ * Minimal WAV file reader/writer for the host tools: PCM 16/24/32-bit and
+ * 32-bit float in, 32-bit float out. Samples are interleaved floats in
+ * -1..1 full scale.
+ */
+
+#ifndef SEYMOUR_WAV_H
+#define SEYMOUR_WAV_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+struct WavData {
+    uint32_t sampleRate;
+    int numChannels;
+    std::vector<float> samples;     // interleaved
+
+    WavData() : sampleRate(0), numChannels(0) {}
+    size_t numFrames() const { return numChannels ? samples.size() / numChannels : 0; }
+};
+
+/**
+ * Load a WAV file. Returns false (with a message on stderr) if the file
+ * cannot be read or is in an unsupported format.
+ */
+bool wavRead(const char* path, WavData& wav);
+
+/**
+ * Write interleaved samples as a 32-bit float WAV file
+ */
+bool wavWrite(const char* path, const WavData& wav);
+
+#endif // SEYMOUR_WAV_H